@@ -0,0 +1,79 @@
+//File: BenchGetters.cxx
+//Info: Microbenchmark of the CVUniverse branch reads. For every branch the getters use, times the string-keyed ChainWrapper lookup (GetVecElem by name)
+//      against the pre-resolved BranchHandle (CVUniverse::GetBranchValue) on the same entries, and prints the cost per call of each.
+//
+//Usage: BenchGetters <MasterAnaDev_NTuple_list/single_file> optional: <n_entries, default 1000> <calls per entry, default 100>
+//Author: David Last dlast@sas.upenn.edu/lastd44@gmail.com
+
+//C++ includes
+#include <iostream>
+#include <iomanip>
+#include <stdlib.h>
+#include <string>
+#include <chrono>
+
+//PlotUtils includes
+#include "PlotUtils/ChainWrapper.h"
+#include "PlotUtils/makeChainWrapper.h"
+
+#include "syst/CVUniverse.h"
+
+#ifndef NCINTEX
+#include "Cintex/Cintex.h"
+#endif
+
+using namespace std;
+
+int main(int argc, char* argv[]) {
+
+  #ifndef NCINTEX
+  ROOT::Cintex::Cintex::Enable();
+  #endif
+
+  if (argc < 2 || argc > 4) {
+    cout << "Check usage..." << endl;
+    return 2;
+  }
+
+  string playlist=string(argv[1]);
+  int nEntries=1000;
+  int nCalls=100;
+  if (argc >= 3) nEntries=atoi(argv[2]);
+  if (argc == 4) nCalls=atoi(argv[3]);
+
+  PlotUtils::ChainWrapper* chain = makeChainWrapperPtr(playlist,"MasterAnaDev");
+  if (nEntries > chain->GetEntries()) nEntries = chain->GetEntries();
+  CVUniverse* CV = new CVUniverse(chain);
+
+  //Keeps the reads from being optimized away
+  double sink = 0.0;
+
+  cout << setw(50) << left << "branch" << setw(14) << right << "by name [ns]" << setw(14) << "handle [ns]" << setw(10) << "ratio" << endl;
+  for (int id=0; id < CVUniverse::kNBranches; ++id){
+    CVUniverse::BranchID branch = (CVUniverse::BranchID)id;
+    const char* name = CVUniverse::GetBranchName(branch);
+    double byNameNs = 0.0;
+    double handleNs = 0.0;
+    long long nTimed = 0;
+    for (int i=0; i<nEntries; ++i){
+      CV->SetEntry(i);
+      //Empty arrays have no element 0 to read
+      if (CV->GetBranchLen(branch) == 0) continue;
+      auto start = chrono::steady_clock::now();
+      for (int call=0; call < nCalls; ++call) sink += CV->GetVecElem(name,0);
+      auto middle = chrono::steady_clock::now();
+      for (int call=0; call < nCalls; ++call) sink += CV->GetBranchValue(branch,0);
+      auto end = chrono::steady_clock::now();
+      byNameNs += chrono::duration<double, nano>(middle-start).count();
+      handleNs += chrono::duration<double, nano>(end-middle).count();
+      nTimed += nCalls;
+    }
+    if (nTimed == 0){
+      cout << setw(50) << left << name << setw(14) << right << "empty" << endl;
+      continue;
+    }
+    cout << setw(50) << left << name << setw(14) << right << fixed << setprecision(1) << byNameNs/nTimed << setw(14) << handleNs/nTimed << setw(10) << setprecision(2) << byNameNs/handleNs << endl;
+  }
+  cout << "(checksum " << sink << ")" << endl;
+  return 0;
+}
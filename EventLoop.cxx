@@ -2,6 +2,14 @@
 //Info: This is a script to run a loop over all events in a single nTuple file and perform some plotting. Will eventually exist as the basis for the loops over events in analysis.
 //
 //Usage: EventLoop.cxx <MasterAnaDev_NTuple_list/single_file> <0=MC/1=PC> <0=tracker/1=targets/2=both> <0=trueSignalOnly/1=trueBackgroundOnly/2=all> <output_directory> <tag_for_naming_files> optional: <n_event g.t. 0 if you want constraint otherwise it'll do all> <1="Dan's",anything else default> <PC non-muon EnergyCut>
+//       Flags, anywhere on the line: --write-skim <file> stores what the loop reads for each entry, --read-skim <file> reads it back instead of the nTuple branches.
+//       --scan-grid <file> counts CV candidates of selected events passing every point of a classifier threshold grid (see obj/ClassifierScan.h) and writes the table next to the histograms.
+//       --record-branches <file> writes every branch read during the run to a whitelist; run it over a few thousand entries.
+//       --branch-whitelist <file> turns off every branch not in the whitelist and caches only the listed ones before the loop.
+//       --signal <n> picks the true signal definition for the Signal/Background samples (TruthTopology::Signal, default 0).
+//       --weights <MINERvA playlist, e.g. minervame6A> fills every histogram with its universe's event weight (flux x GENIE x RPA x 2p2h x MINOS
+//       efficiency, computed once per entry for all universes) and books the flux and GENIE error bands; without it fills are unweighted and only the CV is booked.
+//       --flux-universes <n> sets the number of flux universes (default 100).
 //Author: David Last dlast@sas.upenn.edu/lastd44@gmail.com
 
 //C++ includes
@@ -12,21 +20,35 @@
 #include <sstream>
 #include <fstream>
 #include <vector>
+#include <set>
 #include <numeric>
 #include <algorithm>
 #include <unordered_map>
 #include <bitset>
 #include <time.h>
 #include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <stdexcept>
 
 //ROOT includes
 #include "TInterpreter.h"
 #include "TROOT.h"
+#include "TH1.h"
 #include "TH1F.h"
 #include "TH2F.h"
 #include "THStack.h"
 #include "TFile.h"
+#include "TKey.h"
+#include "TList.h"
 #include "TTree.h"
+#include "TChain.h"
 #include "TDirectory.h"
 #include "TSystemDirectory.h"
 #include "TCanvas.h"
@@ -40,11 +62,21 @@
 //PlotUtils includes??? Trying anything at this point...
 #include "PlotUtils/HistWrapper.h"
 #include "PlotUtils/Hist2DWrapper.h"
+#include "PlotUtils/MnvH1D.h"
 #include "PlotUtils/ChainWrapper.h"
 #include "PlotUtils/makeChainWrapper.h"
+#include "PlotUtils/FluxSystematics.h"
+#include "PlotUtils/GenieSystematics.h"
 
 #include "syst/CVUniverse.h"
+#include "syst/WeightBank.h"
 #include "obj/NeutCands.h"
+#include "obj/AllocCounter.h"
+#include "obj/SkimCache.h"
+#include "obj/ClassifierScan.h"
+#include "obj/BranchWhitelist.h"
+#include "obj/EntryQueue.h"
+#include "obj/CutFlow.h"
 
 #ifndef NCINTEX
 #include "Cintex/Cintex.h"
@@ -54,9 +86,11 @@ using namespace std;
 
 double targetBoundary = 5850.0;
 bitset<4> goodBlob{"1111"};
+bitset<4> is3DBlob{"0001"};
 
-bool PassesFVCuts(CVUniverse& univ, int region){
-  vector<double> vtx = univ.GetVtx();
+//The cuts below only read the per-entry EventKinematics record, which the loop fills per universe as the cuts need it (see obj/EventKinematics.h).
+bool PassesFVCuts(const EventKinematics& evt, int region){
+  const double* vtx = evt.vtx;
   double side = 850.0*2.0/sqrt(3.0);
   if (region == 0){
     if (vtx[2] < targetBoundary || vtx[2] > 8422.0 ) return false;
@@ -72,58 +106,54 @@ bool PassesFVCuts(CVUniverse& univ, int region){
   return false;
 }
 
-bool PassesCleanCCAntiNuCuts(CVUniverse& univ, int isPC, double ECut=10000.0){
+bool PassesCleanCCAntiNuCuts(const EventKinematics& evt, int isPC, double ECut=10000.0){
   int MINOSMatch=0;
   if (isPC){
     //    MINOSMatch=univ.GetIsMinosMatchTrackOLD();
     MINOSMatch=1;
-    TLorentzVector prim_part(univ.GetFSPartPx().at(0),univ.GetFSPartPy().at(0),univ.GetFSPartPz().at(0),univ.GetFSPartE().at(0));
-    if ((prim_part.E()-prim_part.M()) > ECut) return false;
+    if (evt.primaryKE > ECut) return false;
   }
   else{
-    MINOSMatch=univ.GetHasInteractionVertex();
+    MINOSMatch=evt.hasInteractionVertex;
       //MINOSMatch=univ.GetIsMinosMatchTrack();
   }
   return
-    (univ.GetNDeadDiscriminatorsUpstreamMuon() < 2) &&
-    (univ.GetNuHelicity() == 2) &&
+    (evt.nDeadDiscriminators < 2) &&
+    (evt.nuHelicity == 2) &&
     (MINOSMatch == 1) &&
-    (TMath::RadToDeg()*univ.GetThetamu() < 20.0) &&
-    (univ.GetPmu() < 20000.0 && univ.GetPmu() > 1500.0);
+    (TMath::RadToDeg()*evt.Thetamu < 20.0) &&
+    (evt.Pmu < 20000.0 && evt.Pmu > 1500.0);
 }
 
 //Should Code the more general anti-nu CCQE cuts at some point... but this is a focus for Tejin stuff...
-bool PassesTejinRecoilCut(CVUniverse& univ, int isPC, int whichRecoil){
+//The record already holds the recoil picked by whichRecoil.
+bool PassesTejinRecoilCut(const EventKinematics& evt, int isPC){
   if (isPC) return true;
-  double Q2GeV = univ.GetQ2QEPickledGeV();
-  double recoilEGeV = univ.GetRecoilEnergyGeV();
-  if (whichRecoil == 1) recoilEGeV = univ.GetDANRecoilEnergyGeV();
+  double Q2GeV = evt.Q2GeV;
+  double recoilEGeV = evt.recoilEGeV;
   if (Q2GeV < 0.0 || recoilEGeV < 0.0) return false;
   else if (Q2GeV < 0.3) return (recoilEGeV < (0.04+0.43*Q2GeV));
   else if (Q2GeV < 1.4) return (recoilEGeV < (0.08+0.3*Q2GeV));
   else return (recoilEGeV < 0.5);
 }
 
-bool PassesTejinCCQECuts(CVUniverse& univ){
+bool PassesTejinCCQECuts(const EventKinematics& evt){
   //bool PassesRecoilECut = false;
   //recoil energy cut and Q2 calculation are unclear to me. Need investigate...
-  vector<double> EMBlobInfo = univ.GetEMNBlobsTotalEnergyTotalNHits();
+  const EMBlobSummary& EMBlobInfo = evt.EMBlobs;
   return 
-    (univ.GetNTracks() == 1) &&
-    (EMBlobInfo.at(0) < 2) &&
-    (EMBlobInfo.at(1) >= 10.0*EMBlobInfo.at(2)) &&
-    !(univ.GetNImprovedMichel() > 0);//Should this be !=0 ??????????
+    (evt.nTracks == 1) &&
+    (EMBlobInfo.nBlobs < 2) &&
+    (EMBlobInfo.totalE >= 10.0*EMBlobInfo.nHits) &&
+    !(evt.nImprovedMichel > 0);//Should this be !=0 ??????????
 }
 
-int PassesTejinBlobCuts(CVUniverse& univ){
-  NeutronCandidates::NeutCand leadingBlob=univ.GetCurrentLeadingNeutCand();
+int PassesTejinBlobCuts(const EventKinematics& evt, const NeutronCandidates::NeutCandView& leadingBlob){
+  if (!leadingBlob.IsValid()) return 0;
   int leading3D=leadingBlob.GetIs3D();
-  double leadingEGeV = 0.001*leadingBlob.GetTotalE();
   TVector3 leadingPos=leadingBlob.GetBegPos();
   TVector3 leadingFP=leadingBlob.GetFlightPath();
-  TVector3 muonMom(univ.GetMuon4V().Z(),univ.GetMuon4V().Y(),univ.GetMuon4V().Z());
-  double Q2GeV = univ.GetQ2QEPickledGeV();
-  double MnGeV = 0.939566; //Should check what others might use, but this will be close enough for now...
+  TVector3 muonMom(evt.muonPz,evt.muonPy,evt.muonPz);
   if (leadingFP.Mag()==0 || muonMom.Mag()==0) return 0;
   else{
     if((leading3D==1) && (leadingFP.Angle(muonMom) > 0.261799388)){
@@ -134,67 +164,643 @@ int PassesTejinBlobCuts(CVUniverse& univ){
   }
 }
 
-bool PassesCuts(CVUniverse& univ, int isPC, int region, double ECut=10000.0){
-  if (ECut <= 0.0){
-    ECut = 10000.0;
+//Default is CC anti-numu, one muon, nothing else above threshold except at least one neutron. See obj/TruthTopology.h for the variants.
+bool IsTrueSignal(CVUniverse& univ, TruthTopology::Signal signal=TruthTopology::kCCQELikeAntiNuNeutron){
+  return univ.IsTrueSignal(signal);
+}
+
+bool PathExists(string path){
+  struct stat buffer;
+  return (stat (path.c_str(), &buffer) == 0);
+}
+
+//One MnvH1D per histogram: the CV, with a vertical error band for every other booked band
+void Write1DHistsToFile(vector<PlotUtils::HistWrapper<CVUniverse>*> hists, TFile* file){
+  for (auto hist : hists){
+    hist->SyncCVHistos();
+    hist->hist->SetDirectory(file);
+    hist->hist->Write();
   }
-  return
-    PassesFVCuts(univ, region) &&
-    PassesCleanCCAntiNuCuts(univ, isPC, ECut) &&
-    PassesTejinCCQECuts(univ);
 }
 
-bool IsTrueSignal(CVUniverse& univ){
-  int current = univ.GetMCCurrent();
-  int incoming = univ.GetMCIncoming();
-
-  if (current != 1 || incoming != -14) return false;
-
-  int genie_n_muons = 0;
-  int genie_n_mesons = 0;
-  int genie_n_heavy_baryons_plus_pi0s = 0;
-  int genie_n_photons =0;
-  int genie_n_protons = 0;
-  int genie_n_neutrons = 0;
-
-  vector<int> PDGs = univ.GetFSPartPDG();
-  vector<double> Es = univ.GetFSPartE();
-
-  for (unsigned int i=0; i<PDGs.size(); ++i){
-    int pdg = PDGs.at(i);
-    double energy = Es.at(i);
-    double proton_E = 1058.272;
-    double neutron_E = 949.57;
-    if (abs(pdg) == 13) genie_n_muons++;
-    else if ( pdg == 22  && energy > 10) genie_n_photons++;
-    else if ( abs(pdg) == 211 || abs(pdg) == 321 || abs(pdg) == 323 || pdg == 111 || pdg == 130 || pdg == 310 || pdg == 311 || pdg == 313 ){
-      genie_n_mesons++;
+//Files listed in a .txt playlist, one per line. Blank lines and '#' comments are skipped.
+vector<string> ReadPlaylistFiles(string playlist){
+  vector<string> files;
+  ifstream in(playlist.c_str());
+  string line;
+  while (getline(in, line)){
+    size_t first = line.find_first_not_of(" \t\r");
+    if (first == string::npos || line[first] == '#') continue;
+    size_t last = line.find_last_not_of(" \t\r");
+    files.push_back(line.substr(first, last-first+1));
+  }
+  return files;
+}
+
+//The file in dir named prefix + <number of entries> + suffix, or "" if there is none or more than one. The number of entries is returned in nEntries.
+string FindOutputFile(string dir, string prefix, string suffix, long long& nEntries){
+  string found="";
+  int nFound=0;
+  DIR* directory = opendir(dir.c_str());
+  if (!directory) return found;
+  while (dirent* entry = readdir(directory)){
+    string name = entry->d_name;
+    if (name.size() <= prefix.size()+suffix.size()) continue;
+    if (name.compare(0, prefix.size(), prefix) != 0 || name.compare(name.size()-suffix.size(), suffix.size(), suffix) != 0) continue;
+    string count = name.substr(prefix.size(), name.size()-prefix.size()-suffix.size());
+    if (count.find_first_not_of("0123456789") != string::npos) continue;
+    found = dir+name;
+    nEntries = atoll(count.c_str());
+    ++nFound;
+  }
+  closedir(directory);
+  return (nFound == 1) ? found : "";
+}
+
+//Adds up the histograms of several EventLoop output files and writes the sums to output. Histograms are matched by name and cycle.
+//TH1::Add is virtual, so MnvH1Ds add up their vertical and lateral error bands along with the central value.
+bool MergeOutputFiles(const vector<string>& inputs, string output){
+  vector<string> names;
+  //Detached from every file, so the maps own them and closing a file never deletes one
+  map<string, unique_ptr<TH1>> merged;
+  for (unsigned int iFile=0; iFile < inputs.size(); ++iFile){
+    unique_ptr<TFile> in(TFile::Open(inputs[iFile].c_str()));
+    if (!in || in->IsZombie()){
+      cout << "Couldn't open " << inputs[iFile] << " for merging." << endl;
+      return false;
     }
-    else if ( pdg == 3112 || pdg == 3122 || pdg == 3212 || pdg == 3222 || pdg == 4112 || pdg == 4122 || pdg == 4222 || pdg == 411 || pdg == 421 || pdg == 111){
-      genie_n_heavy_baryons_plus_pi0s++;
+    TIter next(in->GetListOfKeys());
+    while (TKey* key = (TKey*)next()){
+      TObject* obj = key->ReadObj();
+      unique_ptr<TH1> hist(dynamic_cast<TH1*>(obj));
+      if (!hist){
+	delete obj;
+	continue;
+      }
+      hist->SetDirectory(0);
+      string name = string(key->GetName())+";"+to_string(key->GetCycle());
+      auto found = merged.find(name);
+      if (found == merged.end()){
+	if (iFile > 0) cout << name << " is only in some of the files being merged." << endl;
+	names.push_back(name);
+	merged[name] = move(hist);
+      }
+      else{
+	PlotUtils::MnvH1D* mnvHist = dynamic_cast<PlotUtils::MnvH1D*>(found->second.get());
+	if (mnvHist) mnvHist->Add(hist.get());
+	else found->second->Add(hist.get());
+      }
     }
-    else if ( pdg == 2212 && energy > proton_E ) genie_n_protons++;
-    else if ( pdg == 2112 && energy > neutron_E) genie_n_neutrons++;
+    in->Close();
   }
 
-  return genie_n_muons == 1 && 
-    genie_n_mesons == 0 && 
-    genie_n_heavy_baryons_plus_pi0s == 0 && 
-    genie_n_photons == 0 && 
-    genie_n_protons == 0 &&
-    genie_n_neutrons > 0;
+  unique_ptr<TFile> outFile(new TFile(output.c_str(),"RECREATE"));
+  if (outFile->IsZombie()) return false;
+  //Written into the file without being attached to it, so they are deleted with the map rather than by Close
+  outFile->cd();
+  for (auto name : names) merged[name]->Write();
+  outFile->Close();
+  return true;
 }
 
-bool PathExists(string path){
-  struct stat buffer;
-  return (stat (path.c_str(), &buffer) == 0);
+//Cut-flow tables of the processes of a --processes run, one after the other. Each process found its own cut order, so their rows can't be added;
+//the events passing and seen are summed at the end.
+bool MergeCutFlows(const vector<string>& inputs, const vector<string>& names, string output){
+  ofstream out(output.c_str());
+  if (!out.is_open()) return false;
+  unsigned long long nPassed=0, nEvents=0;
+  const string total = "Passed all cuts: ";
+  for (unsigned int iFile=0; iFile < inputs.size(); ++iFile){
+    ifstream in(inputs[iFile].c_str());
+    if (!in.is_open()){
+      cout << "Couldn't open " << inputs[iFile] << " for merging." << endl;
+      return false;
+    }
+    out << "#" << names[iFile] << endl;
+    string line;
+    while (getline(in, line)){
+      out << line << endl;
+      if (line.compare(0, total.size(), total) == 0){
+	istringstream counts(line.substr(total.size()));
+	unsigned long long passed=0, events=0;
+	string of;
+	counts >> passed >> of >> events;
+	nPassed += passed;
+	nEvents += events;
+      }
+    }
+  }
+  out << "#All processes" << endl;
+  out << total << nPassed << " of " << nEvents << endl;
+  return true;
 }
 
-void Write1DHistsToFile(vector<PlotUtils::HistWrapper<CVUniverse>*> hists, CVUniverse* univ, TFile* file){
-  for (auto hist : hists){
-    hist->SyncCVHistos();
-    hist->univHist(univ)->SetDirectory(file);
-    hist->univHist(univ)->Write();
+//--processes K: splits the playlist into K contiguous groups of files, runs EventLoop on each group in its own process with the same options,
+//waits for all of them and merges their output files. The processes work in a new directory of their own under outDir, so nothing they write
+//can be mistaken for a whole-playlist output or be left over from an earlier run; each logs to its own file there.
+//Their cut flows, classifier scans (scanGrid) and branch whitelists (recordBranches) are merged too: each process records branches to its own file.
+int RunFanOut(vector<string> childArgs, int nProcesses, string playlist, string playlistStub, string outDir, string outPrefix, string tag, string scanGrid, string recordBranches){
+  vector<string> files = ReadPlaylistFiles(playlist);
+  if (files.empty()){
+    cout << "No files in playlist " << playlist << endl;
+    return 9;
+  }
+  if (nProcesses > (int)files.size()) nProcesses = files.size();
+
+  string runTemplate = outDir+"parts_"+playlistStub+"_"+tag+"_XXXXXX";
+  vector<char> runName(runTemplate.begin(), runTemplate.end());
+  runName.push_back('\0');
+  if (!mkdtemp(runName.data())){
+    cout << "Couldn't make a directory for the processes in " << outDir << endl;
+    return 9;
+  }
+  string runDir = string(runName.data())+"/";
+  childArgs[5] = runDir;
+
+  map<pid_t, int> running;
+  vector<string> partStubs;
+  vector<string> partPlaylists;
+  for (int iPart=0; iPart < nProcesses; ++iPart){
+    string partStub = playlistStub+"_part"+to_string(iPart+1)+"of"+to_string(nProcesses);
+    string partPlaylist = runDir+partStub+".txt";
+    ofstream partOut(partPlaylist.c_str());
+    for (unsigned int iFile=(iPart*files.size())/nProcesses; iFile < ((iPart+1)*files.size())/nProcesses; ++iFile) partOut << files[iFile] << endl;
+    partOut.close();
+    partStubs.push_back(partStub);
+    partPlaylists.push_back(partPlaylist);
+
+    string logName = runDir+partStub+"_"+tag+".log";
+    childArgs[1] = partPlaylist;
+    vector<string> partArgs = childArgs;
+    if (recordBranches != ""){
+      partArgs.push_back("--record-branches");
+      partArgs.push_back(runDir+partStub+"_"+tag+"_Branches.txt");
+    }
+    pid_t pid = fork();
+    if (pid < 0){
+      cout << "Couldn't start a process for " << partPlaylist << endl;
+      return 9;
+    }
+    if (pid == 0){
+      int log = open(logName.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+      if (log >= 0){
+	dup2(log, 1);
+	dup2(log, 2);
+	close(log);
+      }
+      vector<char*> childArgv;
+      for (auto& arg : partArgs) childArgv.push_back(const_cast<char*>(arg.c_str()));
+      childArgv.push_back(NULL);
+      execvp(childArgv[0], childArgv.data());
+      _exit(127);
+    }
+    running[pid] = iPart;
+    cout << "Started process " << pid << " on " << partPlaylist << ", logging to " << logName << endl;
+  }
+
+  int nFailed=0;
+  time_t start = time(NULL);
+  while (!running.empty()){
+    int status=0;
+    pid_t pid = waitpid(-1, &status, 0);
+    if (pid < 0) break;
+    auto found = running.find(pid);
+    if (found == running.end()) continue;
+    bool ok = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    if (!ok) ++nFailed;
+    cout << partStubs[found->second] << (ok ? " finished" : " FAILED") << " after " << (long)(time(NULL)-start) << " s. " << running.size()-1 << " still running." << endl;
+    running.erase(found);
+  }
+  if (nFailed){
+    cout << nFailed << " of " << nProcesses << " processes failed; not merging. See their logs in " << runDir << endl;
+    return 9;
+  }
+
+  vector<string> outputs;
+  vector<string> cutFlows;
+  vector<string> scans;
+  long long nEntries=0;
+  for (auto partStub : partStubs){
+    long long nPartEntries=0;
+    string partPrefix = outPrefix+partStub+"_"+tag+"_";
+    string output = FindOutputFile(runDir, partPrefix, "_Events.root", nPartEntries);
+    if (output == ""){
+      cout << "No output from " << partStub << endl;
+      return 9;
+    }
+    outputs.push_back(output);
+    nEntries += nPartEntries;
+    long long nCounted=0;
+    cutFlows.push_back(FindOutputFile(runDir, partPrefix, "_Events_CutFlow.txt", nCounted));
+    if (scanGrid != "") scans.push_back(FindOutputFile(runDir, partPrefix, "_Events_ClassifierScan.txt", nCounted));
+  }
+  string mergedStub = outDir+outPrefix+playlistStub+"_"+tag+"_"+to_string(nEntries)+"_Events";
+  string merged = mergedStub+".root";
+  if (!MergeOutputFiles(outputs, merged)) return 9;
+  cout << "Merged " << outputs.size() << " outputs into " << merged << endl;
+
+  if (!MergeCutFlows(cutFlows, partStubs, mergedStub+"_CutFlow.txt")) return 9;
+  cout << "Wrote cut flow " << mergedStub << "_CutFlow.txt" << endl;
+
+  if (scanGrid != ""){
+    NeutronCandidates::ClassifierScan scan;
+    if (!scan.ReadGrid(scanGrid)) return 9;
+    for (auto partScan : scans){
+      if (!scan.AddTable(partScan)) return 9;
+    }
+    ofstream scanOut((mergedStub+"_ClassifierScan.txt").c_str());
+    scan.Write(scanOut);
+    cout << "Wrote classifier scan " << mergedStub << "_ClassifierScan.txt" << endl;
+  }
+
+  if (recordBranches != ""){
+    set<string> branches;
+    for (auto partStub : partStubs){
+      vector<string> read = BranchWhitelist::Read(runDir+partStub+"_"+tag+"_Branches.txt");
+      branches.insert(read.begin(), read.end());
+    }
+    if (!BranchWhitelist::Write(recordBranches, vector<string>(branches.begin(), branches.end()))) return 9;
+    cout << "Recorded " << branches.size() << " branches to " << recordBranches << endl;
+  }
+  for (auto partPlaylist : partPlaylists) unlink(partPlaylist.c_str());
+  cout << "The processes' logs and outputs are in " << runDir << endl;
+  return 0;
+}
+
+//Histogram bin of a blob's parent particle. Anything not listed goes in bin 0.
+int GetPDGBin(int PDG){
+  switch (PDG){
+  case 2112: return 2;
+  case 2212: return 3;
+  case 111: return 4;
+  case 211: return 5;
+  case -211: return 6;
+  case 22: return 7;
+  case 11: case -11: return 8;
+  case 13: case -13: return 9;
+  default: return 0;
+  }
+}
+
+//Axes of EventLoop's histogram bank. Each histogram is one variable, in one region, at one selection stage, for one interaction type.
+enum HistStage{ kStageCCQE, kStageRecoil, kStageTejin, kStageTejinTrackerONLY, kNHistStages };
+enum HistRegion{ kRegionTracker, kRegionTarget, kRegionALL, kRegionLeadBlob, kRegionEvent, kNHistRegions };
+enum HistVariable{ kVarPrimaryParent, kVarLength, kVarAvgdEdx, kVarBlobE, kVarDist, kVarZdist, kVarPassesClassifier, kVarLocation,
+		   kVarN3DBlobs, kVarNGoodBlobs, kVarNBlobs, kVarAvgBlobEnergy, kVarRecoilEnergyGeV, kNHistVariables };
+enum HistIntType{ kIntOther, kIntQE, kIntRES, kIntDIS, kInt2p2h, kNHistIntTypes };
+
+//Regions a variable is booked in, as bits 1 << HistRegion
+const unsigned int kBlobRegions = (1 << kRegionTracker) | (1 << kRegionTarget) | (1 << kRegionALL) | (1 << kRegionLeadBlob);
+const unsigned int kLeadBlobRegion = (1 << kRegionLeadBlob);
+const unsigned int kEventRegion = (1 << kRegionEvent);
+
+//One row per HistVariable, in enum order. The binning is shared by every region, stage and interaction type the variable is booked for.
+struct HistFamily{
+  HistVariable variable;
+  unsigned int regions;
+  const char* name;
+  const char* title;
+  //Title in the leading blob region, NULL for the same as title
+  const char* leadBlobTitle;
+  const char* xAxis;
+  int nBins;
+  double min;
+  double max;
+};
+
+const HistFamily histFamilies[kNHistVariables] = {
+  {kVarPrimaryParent, kBlobRegions, "primary_parent", "Primary Particle Matched To Blob", "Primary Parent Matched To Leading Blob", "", 10, 0, 10},
+  {kVarLength, kBlobRegions, "length", "Blob Length", "Leading Blob Length", "Len. [mm]", 50, 0, 500},
+  {kVarAvgdEdx, kBlobRegions, "avg_dEdx", "Blob Energy/Length", "Leading Blob Energy/Length", "dE/dx [MeV/mm]", 25, 0, 50},
+  {kVarBlobE, kBlobRegions, "blobE", "Blob Energy", "Leading Blob Energy", "E [MeV]", 50, 0, 150},
+  {kVarDist, kBlobRegions, "dist", "Blob Dist. To Vtx.", "Leading Blob Dist. to Vtx", "Dist. [mm]", 300, 0, 3000},
+  {kVarZdist, kBlobRegions, "Zdist", "Blob Absolute Z Dist. To Vtx.", "Leading Blob Absolute Z Dist. to Vtx.", "Dist. [mm]", 300, 0, 3000},
+  {kVarPassesClassifier, kLeadBlobRegion, "passes_classifier", "Leading Blob Passes", NULL, "", 2, 0, 2},
+  {kVarLocation, kLeadBlobRegion, "location", "Leading Blob Location", NULL, "", 2, 0, 2},
+  {kVarN3DBlobs, kEventRegion, "n3DBlobs", "No. 3D Blobs", NULL, "No.", 10, 0, 10},
+  {kVarNGoodBlobs, kEventRegion, "nGoodBlobs", "No. Blobs Which Pass", NULL, "No.", 10, 0, 10},
+  {kVarNBlobs, kEventRegion, "nBlobs", "No. of Blobs", NULL, "No.", 100, 0, 100},
+  {kVarAvgBlobEnergy, kEventRegion, "AvgBlobEnergy", "Avg. Blob Energy", NULL, "Avg. E [MeV]", 50, 0, 50},
+  {kVarRecoilEnergyGeV, kEventRegion, "RecoilEnergyGeV", "Recoil Energy", NULL, "RecoilE [GeV]", 50, 0, 1.5},
+};
+
+//Every histogram EventLoop fills, booked up front into one array for one set of universes. A threaded run books a copy per worker and adds them up before writing.
+//Names and titles are the same as they were as separate HistWrapper maps, e.g. hw_tracker_length_Tejin_QE.
+class EventLoopHists{
+ private:
+  //Indexed by GetSlot()
+  vector<PlotUtils::HistWrapper<CVUniverse>> fHists;
+  //Each slot's histogram for each universe, at slot*fNUniverses + the universe's WeightBank index
+  vector<TH1D*> fUnivHists;
+  int fNUniverses;
+  //Booked (region, variable) pairs in write order, and the position of each one there (-1 where it isn't booked)
+  int fFamilies[kNHistRegions][kNHistVariables];
+  //Variables booked in each region
+  vector<int> fVariables[kNHistRegions];
+
+  //GENIE interaction type (already folded to 0, 1, 2, 3 or 8) to HistIntType
+  static int GetIntTypeIndex(int intType){
+    static const int intTypeIndex[9] = { kIntOther, kIntQE, kIntRES, kIntDIS, kIntOther, kIntOther, kIntOther, kIntOther, kInt2p2h };
+    return (intType >= 0 && intType < 9) ? intTypeIndex[intType] : kIntOther;
+  };
+
+  int GetSlot(int stage, int region, int variable, int type) const {
+    return (fFamilies[region][variable]*kNHistStages + stage)*kNHistIntTypes + type;
+  };
+
+ public:
+  //Written out region by region, then variable, stage and interaction type in the order QE, RES, DIS, 2p2h, Other
+  vector<PlotUtils::HistWrapper<CVUniverse>*> histsALL;
+
+  //The universes need their WeightBank index already
+  EventLoopHists(map< string, vector<CVUniverse*>>& error_bands){
+    const char* regionNames[kNHistRegions] = { "tracker_", "target_", "ALL_", "leadBlob_", "" };
+    const char* regionYAxes[kNHistRegions] = { "Blobs", "Blobs", "Blobs", "Events", "Events" };
+    const char* stageNames[kNHistStages] = { "CCQE", "Recoil", "Tejin", "Tejin_TrackerONLY" };
+    const char* stageTitles[kNHistStages] = { "CCQE", "CCQE, Recoil", "CCQE, Recoil, Blob", "CCQE, Recoil, Blob, Tracker Blob" };
+    const char* typeNames[kNHistIntTypes] = { "Other", "QE", "RES", "DIS", "2p2h" };
+    const int writeOrder[kNHistIntTypes] = { kIntQE, kIntRES, kIntDIS, kInt2p2h, kIntOther };
+
+    int nFamilies = 0;
+    for (int region=0; region < kNHistRegions; ++region){
+      for (int variable=0; variable < kNHistVariables; ++variable){
+	fFamilies[region][variable] = -1;
+	if (histFamilies[variable].regions & (1 << region)){
+	  fFamilies[region][variable] = nFamilies++;
+	  fVariables[region].push_back(variable);
+	}
+      }
+    }
+    fHists.reserve(nFamilies*kNHistStages*kNHistIntTypes);
+    for (int region=0; region < kNHistRegions; ++region){
+      for (int variable : fVariables[region]){
+	const HistFamily& hist = histFamilies[variable];
+	string histTitle = (region == kRegionLeadBlob && hist.leadBlobTitle) ? hist.leadBlobTitle : hist.title;
+	for (int stage=0; stage < kNHistStages; ++stage){
+	  for (int type=0; type < kNHistIntTypes; ++type){
+	    string name = string("hw_")+regionNames[region]+hist.name+"_"+stageNames[stage]+"_"+typeNames[type];
+	    string title = string("True ")+typeNames[type]+" "+histTitle+" ("+stageTitles[stage]+");"+hist.xAxis+";"+regionYAxes[region];
+	    fHists.push_back(PlotUtils::HistWrapper<CVUniverse>(TString(name),TString(title),hist.nBins,hist.min,hist.max,error_bands));
+	  }
+	  for (int type=0; type < kNHistIntTypes; ++type) histsALL.push_back(&fHists[GetSlot(stage, region, variable, writeOrder[type])]);
+	}
+      }
+    }
+
+    fNUniverses = 0;
+    for (auto band : error_bands) fNUniverses += band.second.size();
+    fUnivHists.assign(fHists.size()*fNUniverses, NULL);
+    for (unsigned int slot=0; slot < fHists.size(); ++slot){
+      for (auto band : error_bands){
+	for (auto universe : band.second) fUnivHists[slot*fNUniverses + universe->GetWeightIndex()] = fHists[slot].univHist(universe);
+      }
+    }
+  };
+
+  //Fills every variable booked in the region with its entry in values, indexed by HistVariable
+  void FillAll(HistStage stage, HistRegion region, int intType, const CVUniverse* universe, const double* values, double wgt){
+    int type = GetIntTypeIndex(intType);
+    int univ = universe->GetWeightIndex();
+    for (int variable : fVariables[region]) fUnivHists[GetSlot(stage,region,variable,type)*fNUniverses + univ]->Fill(values[variable], wgt);
+  };
+};
+
+//Adds each of from's universe histograms to the matching universe histogram in into. Both sets must be booked from error bands built the same way.
+void AddHists(EventLoopHists& into, map< string, vector<CVUniverse*>>& intoBands, EventLoopHists& from, map< string, vector<CVUniverse*>>& fromBands){
+  for (unsigned int iHist=0; iHist < into.histsALL.size(); ++iHist){
+    for (auto band : intoBands){
+      vector<CVUniverse*>& fromUniverses = fromBands[band.first];
+      for (unsigned int iUniv=0; iUniv < band.second.size(); ++iUniv){
+	into.histsALL[iHist]->univHist(band.second[iUniv])->Add(from.histsALL[iHist]->univHist(fromUniverses[iUniv]));
+      }
+    }
+  }
+}
+
+//Per-run settings the loop body reads
+struct LoopOptions{
+  int isPC;
+  int region;
+  int sample;
+  int whichRecoil;
+  int signalDef;
+  double PCECut;
+};
+
+//What the selection's cut nodes look at: the per-entry kinematics record, and the universe that fills it and answers the truth sample split.
+//Each node asks for the parts of the record it reads, so the record only ever holds what the nodes run so far needed.
+struct SelectionInput{
+  EventKinematics* evt;
+  CVUniverse* univ;
+  int isPC;
+  int whichRecoil;
+
+  const EventKinematics& Get(unsigned int parts) const {
+    if ((evt->filled & parts) != parts) univ->FillEventKinematics(*evt, parts, isPC, whichRecoil);
+    return *evt;
+  };
+};
+
+//The event selection as CutFlow nodes. They all commute, so after the warm-up the engine runs them cheapest and most rejecting first.
+CutFlow<SelectionInput>* MakeSelection(const LoopOptions& opt){
+  CutFlow<SelectionInput>* selection = new CutFlow<SelectionInput>();
+  double ECut = (opt.PCECut <= 0.0) ? 10000.0 : opt.PCECut;
+  int isPC = opt.isPC;
+  int region = opt.region;
+  TruthTopology::Signal signal = (TruthTopology::Signal)opt.signalDef;
+  unsigned int cleanParts = EventKinematics::kMuon | EventKinematics::kCounts | (isPC ? EventKinematics::kPrimary : 0);
+  selection->AddCut("FV", CutFlow<SelectionInput>::kScalar, [region](const SelectionInput& in){ return PassesFVCuts(in.Get(EventKinematics::kVertex), region); });
+  selection->AddCut("CleanCCAntiNu", CutFlow<SelectionInput>::kScalar, [isPC, ECut, cleanParts](const SelectionInput& in){ return PassesCleanCCAntiNuCuts(in.Get(cleanParts), isPC, ECut); });
+  selection->AddCut("TejinCCQE", CutFlow<SelectionInput>::kScalar, [](const SelectionInput& in){ return PassesTejinCCQECuts(in.Get(EventKinematics::kCounts | EventKinematics::kEMBlobs)); });
+  if (opt.sample == 0) selection->AddCut("TrueSignal", CutFlow<SelectionInput>::kTruth, [signal](const SelectionInput& in){ return IsTrueSignal(*in.univ, signal); });
+  else if (opt.sample == 1) selection->AddCut("TrueBackground", CutFlow<SelectionInput>::kTruth, [signal](const SelectionInput& in){ return !IsTrueSignal(*in.univ, signal); });
+  return selection;
+}
+
+//Everything one thread of the loop touches: its own chain, universes on that chain, and histograms and a classifier scan for those universes
+struct LoopWorker{
+  //NULL when every entry comes from a skim
+  PlotUtils::ChainWrapper* chain;
+  CVUniverse* CV;
+  map< string, vector<CVUniverse*>> error_bands;
+  //Every universe in error_bands, CV first
+  vector<CVUniverse*> universes;
+  //Every universe reads its unshifted per-entry quantities from one store that the first universe to ask fills
+  SharedEntry sharedEntry;
+  WeightBank* weights;
+  EventLoopHists* hists;
+  NeutronCandidates::ClassifierScan* scan;
+  CutFlow<SelectionInput>* selection;
+  //Only for --record-branches
+  BranchWhitelist::Recorder* recorder;
+};
+
+LoopWorker* MakeLoopWorker(string playlist, const LoopOptions& opt, bool useWeights, SkimReader* skimReader){
+  LoopWorker* worker = new LoopWorker();
+  //A skim holds everything the loop reads except the PlotUtils reweights, so the chain is only opened to read those or without a skim
+  worker->chain = (!skimReader || useWeights) ? makeChainWrapperPtr(playlist,"MasterAnaDev") : NULL;
+  worker->CV = new CVUniverse(worker->chain);
+  worker->error_bands[string("cv")].push_back(worker->CV);
+  //Weighted runs also book the flux and GENIE bands. Each of their universes shifts one factor of the CV weight.
+  if (useWeights){
+    auto addBands = [worker](const map< string, vector<CVUniverse*>>& bands, int factor){
+      for (auto band : bands){
+	for (auto universe : band.second) universe->SetBandFactor(factor);
+	worker->error_bands[band.first] = band.second;
+      }
+    };
+    addBands(PlotUtils::GetFluxSystematicsMap<CVUniverse>(worker->chain, PlotUtils::MinervaUniverse::GetNFluxUniverses()), CVUniverse::kFluxFactor);
+    addBands(PlotUtils::GetGenieSystematicsMap<CVUniverse>(worker->chain), CVUniverse::kGenieFactor);
+  }
+  for (auto band : worker->error_bands){
+    for (auto universe : band.second){
+      universe->SetSharedEntry(&worker->sharedEntry);
+      if (skimReader) universe->SetSkim(skimReader);
+    }
+  }
+  //One contiguous weight per universe, refreshed once per entry
+  worker->weights = new WeightBank(worker->error_bands, useWeights);
+  worker->hists = new EventLoopHists(worker->error_bands);
+  worker->universes.push_back(worker->CV);
+  for (auto band : worker->error_bands){
+    for (auto universe : band.second){
+      if (universe != worker->CV) worker->universes.push_back(universe);
+    }
+  }
+  worker->scan = NULL;
+  worker->selection = MakeSelection(opt);
+  worker->recorder = NULL;
+  return worker;
+}
+
+void ProcessEntry(LoopWorker& worker, Long64_t i, const LoopOptions& opt, SkimWriter* skimWriter){
+  CVUniverse* CV = worker.CV;
+  WeightBank& weights = *worker.weights;
+  EventLoopHists& hists = *worker.hists;
+  NeutronCandidates::ClassifierScan* scan = worker.scan;
+  int isPC = opt.isPC;
+  int whichRecoil = opt.whichRecoil;
+  int n3DBlobs=0;
+  int nGoodBlobs=0;
+  double blobESum=0.0;
+
+  //Before anything reads entry i, so a file change is seen while the old file is still loaded
+  if (worker.recorder) worker.recorder->SetEntry(i);
+  for (auto universe : worker.universes) universe->SetEntry(i);
+  weights.SetEntry();
+  for (auto universe : worker.universes){
+    n3DBlobs=0;
+    nGoodBlobs=0;
+    blobESum=0.0;
+    //A skim needs the candidates of every entry, selected or not
+    bool writesSkim = (skimWriter && universe == CV);
+    if (writesSkim){
+      universe->UpdateNeutCands();
+      CV->WriteSkimEntry(*skimWriter);
+    }
+    //The reco cuts read the kinematics record, which each node fills only as far as it needs. The selection engine runs them and the truth
+    //sample split in its measured order, so most entries stop after the vertex without the muon, recoil or truth FS-particle getters running.
+    EventKinematics evt;
+    evt.filled = 0;
+    //Only the CV pass is counted and timed, so the cut flow is per entry. The CV runs first and pays the cold reads the other universes then share.
+    SelectionInput input = {&evt, universe, isPC, whichRecoil};
+    bool passes = (universe == CV) ? worker.selection->Passes(input) : worker.selection->Evaluate(input);
+    if (!passes) continue;
+    universe->FillEventKinematics(evt, EventKinematics::kAll, isPC, whichRecoil);
+    double wgt = weights.GetWeight(universe);
+    //Survivors load the blob branches, each branch only now and only for this entry
+    if (!writesSkim) universe->UpdateNeutCands();
+    int nBlobs = universe->GetNNeutCands();
+    double recoilEnergy = evt.recoilEGeV;
+    //Passes CCQE Cuts that matche Tejin's selection
+    {
+	  
+      //int nFSPart = universe->GetNFSPart();
+      int intType = evt.intType;
+      NeutronCandidates::NeutCandView leadBlob = universe->GetCurrentLeadingNeutCandView();
+
+      //Counted from the event's packed classifier bits rather than inside each candidate loop below
+      n3DBlobs = universe->GetNNeutCandsPassing(is3DBlob);
+      nGoodBlobs = universe->GetNNeutCandsPassing(goodBlob);
+
+      if (intType > 8){
+	intType=0;
+      }
+      else if (intType < 1){
+	intType=0;
+      }
+      else if (intType > 3 && intType < 8){
+	intType=0;
+      }
+
+      //After the fold, so the scan's interaction types match the histograms'
+      if (scan && universe == CV){
+	for (const auto& cand: universe->GetCurrentNeutCands()) scan->Fill(cand, intType, GetPDGBin(cand.GetTopMCPID()));
+      }
+
+      //The stages are nested, so an event fills every stage up to the last one it passes. I'm not going to treat the Tejin Blob Cut as
+      //special/independent of the recoil cut, and the Tracker ONLY stage is the additional requirement of the chosen blob being in the tracker.
+      int TejinBlobValue = 0;
+      int nStages = 1;
+      if (PassesTejinRecoilCut(evt, isPC)){
+	++nStages;
+	TejinBlobValue = PassesTejinBlobCuts(evt, leadBlob);
+	if (TejinBlobValue) ++nStages;
+	if (TejinBlobValue==2) ++nStages;
+      }
+
+      //Blob level plots, in all of the detector and in the tracker or target region the blob starts in
+      double values[kNHistVariables];
+      for (const auto& cand: universe->GetCurrentNeutCands()){
+	int PTrackID = cand.GetMCParentTrackID();
+	/*
+	if (PTrackID > nFSPart){
+	  //Add something like this to learn how often this happened? ++nMultiIntBlobs;
+	  continue;
+	  }*/
+	values[kVarPrimaryParent] = GetPDGBin((PTrackID==0 && !isPC) ? cand.GetMCPID() : cand.GetTopMCPID());
+	values[kVarLength] = cand.GetLength();
+	values[kVarAvgdEdx] = cand.GetdEdx();
+	values[kVarBlobE] = cand.GetTotalE();
+	values[kVarDist] = cand.GetFlightPathMag();
+	values[kVarZdist] = abs(cand.GetFlightPathZ());
+	blobESum += values[kVarBlobE];
+	HistRegion candRegion = (cand.GetBegZ() > targetBoundary) ? kRegionTracker : kRegionTarget;
+	for (int stage=0; stage < nStages; ++stage){
+	  hists.FillAll((HistStage)stage, kRegionALL, intType, universe, values, wgt);
+	  hists.FillAll((HistStage)stage, candRegion, intType, universe, values, wgt);
+	}
+      }
+
+      //Event level plots, of the leading blob and of the event's blobs as a whole
+      values[kVarPrimaryParent] = 0;
+      values[kVarLength] = -999.0;
+      values[kVarAvgdEdx] = -1.0;
+      values[kVarBlobE] = -999.0;
+      values[kVarDist] = -999.0;
+      values[kVarZdist] = -999.0;
+      values[kVarPassesClassifier] = 0;
+      values[kVarLocation] = -1;
+      if (leadBlob.IsValid()){
+	values[kVarPrimaryParent] = GetPDGBin(leadBlob.GetTopMCPID());
+	values[kVarLength] = leadBlob.GetLength();
+	values[kVarAvgdEdx] = leadBlob.GetdEdx();
+	values[kVarBlobE] = leadBlob.GetTotalE();
+	values[kVarDist] = leadBlob.GetFlightPathMag();
+	values[kVarZdist] = abs(leadBlob.GetFlightPathZ());
+	values[kVarPassesClassifier] = (leadBlob.GetClassifier()==goodBlob) ? 1 : 0;
+	values[kVarLocation] = (leadBlob.GetFlightPathZ() > targetBoundary) ? 1 : 0;
+      }
+      values[kVarN3DBlobs] = n3DBlobs;
+      values[kVarNGoodBlobs] = nGoodBlobs;
+      values[kVarNBlobs] = nBlobs;
+      values[kVarAvgBlobEnergy] = blobESum/((double)(nBlobs));
+      values[kVarRecoilEnergyGeV] = recoilEnergy;
+      for (int stage=0; stage < nStages; ++stage){
+	hists.FillAll((HistStage)stage, kRegionLeadBlob, intType, universe, values, wgt);
+	hists.FillAll((HistStage)stage, kRegionEvent, intType, universe, values, wgt);
+      }
+    }
   }
 }
 
@@ -204,6 +810,66 @@ int main(int argc, char* argv[]) {
   ROOT::Cintex::Cintex::Enable();
   #endif
 
+  //EventLoop --merge out.root in1.root in2.root ... adds up the histograms of runs over separate entries, e.g. the shards of one playlist
+  if (argc >= 4 && string(argv[1]) == "--merge"){
+    return MergeOutputFiles(vector<string>(argv+3, argv+argc), string(argv[2])) ? 0 : 9;
+  }
+
+  //Optional "--flag value" pairs can go anywhere, so pull them out before the positional arguments are read
+  string writeSkim="";
+  string readSkim="";
+  string scanGrid="";
+  bool useWeights=false;
+  string weightPlaylist="";
+  int nFluxUniverses=100;
+  int signalDef=TruthTopology::kCCQELikeAntiNuNeutron;
+  string recordBranches="";
+  string branchWhitelist="";
+  int nThreads=1;
+  int nProcesses=1;
+  Long64_t firstEntry=0;
+  Long64_t lastEntry=-1;
+  int shardIndex=0;
+  int nShards=0;
+  vector<char*> args;
+  //Options handed on to the processes of a --processes run
+  vector<string> childFlags;
+  for (int iArg=0; iArg<argc; ++iArg){
+    string arg=string(argv[iArg]);
+    int firstArg=iArg;
+    if (arg == "--processes" && iArg+1 < argc){
+      nProcesses=atoi(argv[++iArg]);
+      continue;
+    }
+    if (arg == "--write-skim" && iArg+1 < argc) writeSkim=string(argv[++iArg]);
+    else if (arg == "--read-skim" && iArg+1 < argc) readSkim=string(argv[++iArg]);
+    else if (arg == "--scan-grid" && iArg+1 < argc) scanGrid=string(argv[++iArg]);
+    else if (arg == "--weights" && iArg+1 < argc){
+      useWeights=true;
+      weightPlaylist=string(argv[++iArg]);
+    }
+    else if (arg == "--flux-universes" && iArg+1 < argc) nFluxUniverses=atoi(argv[++iArg]);
+    else if (arg == "--signal" && iArg+1 < argc) signalDef=atoi(argv[++iArg]);
+    else if (arg == "--record-branches" && iArg+1 < argc) recordBranches=string(argv[++iArg]);
+    else if (arg == "--branch-whitelist" && iArg+1 < argc) branchWhitelist=string(argv[++iArg]);
+    else if (arg == "--threads" && iArg+1 < argc) nThreads=atoi(argv[++iArg]);
+    else if (arg == "--first-entry" && iArg+1 < argc) firstEntry=atoll(argv[++iArg]);
+    else if (arg == "--last-entry" && iArg+1 < argc) lastEntry=atoll(argv[++iArg]);
+    else if (arg == "--shard" && iArg+2 < argc){
+      shardIndex=atoi(argv[++iArg]);
+      nShards=atoi(argv[++iArg]);
+    }
+    else{
+      args.push_back(argv[iArg]);
+      continue;
+    }
+    //Each process of a --processes run records to its own whitelist, which RunFanOut merges
+    if (arg == "--record-branches") continue;
+    for (int iFlag=firstArg; iFlag<=iArg; ++iFlag) childFlags.push_back(argv[iFlag]);
+  }
+  argc=args.size();
+  argv=args.data();
+
   //Pass an input file name to this script now
   if (argc < 7 || argc > 10) {
     cout << "Check usage..." << endl;
@@ -216,12 +882,12 @@ int main(int argc, char* argv[]) {
   int sample=atoi(argv[4]);
   string outDir=string(argv[5]);
   string tag=string(argv[6]);
-  int nEntries=0;
+  Long64_t nEntries=0;
   int whichRecoil=0;
   double PCECut=-1.0;
 
   if (argc >= 8){
-    nEntries=atoi(argv[7]);
+    nEntries=atoll(argv[7]);
   }
   if (argc>=9){
     whichRecoil=atoi(argv[8]);
@@ -248,6 +914,42 @@ int main(int argc, char* argv[]) {
     return 5;
   } 
 
+  if (signalDef < 0 || signalDef >= TruthTopology::kNSignals){
+    cout << "Check obj/TruthTopology.h for the signal definitions." << endl;
+    return 5;
+  }
+
+  if (nThreads < 1) nThreads=1;
+  if (nProcesses > 1 && (writeSkim != "" || readSkim != "")){
+    cout << "Skims follow the entry numbering of the whole playlist, so --processes is ignored with --write-skim or --read-skim." << endl;
+    nProcesses=1;
+  }
+  if (nProcesses > 1 && nEntries > 0){
+    cout << "--processes splits the playlist by files, not entries, so it is ignored with a number of events." << endl;
+    nProcesses=1;
+  }
+  bool hasRange = (firstEntry > 0 || lastEntry >= 0 || nShards > 0);
+  if (nProcesses > 1 && hasRange){
+    cout << "--processes splits the whole playlist, so it is ignored with --first-entry, --last-entry or --shard." << endl;
+    nProcesses=1;
+  }
+  if (nShards < 0 || (nShards > 0 && (shardIndex < 0 || shardIndex >= nShards))){
+    cout << "--shard k n needs 0 <= k < n." << endl;
+    return 2;
+  }
+  if (firstEntry < 0){
+    cout << "--first-entry can't be negative." << endl;
+    return 2;
+  }
+  if (hasRange && writeSkim != ""){
+    cout << "A skim has to cover the playlist from its first entry, so --write-skim can't be used with an entry range or shard." << endl;
+    return 2;
+  }
+  if (nThreads > 1 && writeSkim != ""){
+    cout << "A skim is written in entry order, so --write-skim runs on one thread." << endl;
+    nThreads=1;
+  }
+
   string txtExt = ".txt";
   string rootExt = ".root";
   string slash = "/";
@@ -280,1059 +982,221 @@ int main(int argc, char* argv[]) {
   map<int,TString>regionNames={{0,"tracker"},{1,"nuke"},{2,"fullID"},};
   map<int,TString>sampleNames={{0,"Signal"},{1,"Background"},{2, "AllSelected"}};
 
-  unordered_map<int,int> PDGbins;
-  PDGbins[2112] = 2;
-  PDGbins[2212] = 3;
-  PDGbins[111] = 4;
-  PDGbins[211] = 5;
-  PDGbins[-211] = 6;
-  PDGbins[22] = 7;
-  PDGbins[11] = 8;
-  PDGbins[-11] = 8;
-  PDGbins[-13] = 9;
-  PDGbins[13] = 9;
-
-  PlotUtils::ChainWrapper* chain = makeChainWrapperPtr(playlist,"MasterAnaDev");
-  
-  CVUniverse* CV = new CVUniverse(chain);
-  map< string, vector<CVUniverse*>> error_bands;
-  error_bands[string("CV")].push_back(CV);
-
-  map<int, TString> typeNames={{1,"QE"},{2,"RES"},{3,"DIS"},{8,"2p2h"},{0,"Other"}};
-
-  //Blob Level Plots
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_tracker_primary_parent_CCQE;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_tracker_primary_parent_Recoil;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_tracker_primary_parent_Tejin;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_tracker_primary_parent_Tejin_TrackerONLY;
-
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_tracker_length_CCQE;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_tracker_length_Recoil;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_tracker_length_Tejin;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_tracker_length_Tejin_TrackerONLY;
-
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_tracker_avg_dEdx_CCQE;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_tracker_avg_dEdx_Recoil;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_tracker_avg_dEdx_Tejin;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_tracker_avg_dEdx_Tejin_TrackerONLY;
-
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_tracker_blobE_CCQE;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_tracker_blobE_Recoil;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_tracker_blobE_Tejin;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_tracker_blobE_Tejin_TrackerONLY;
-
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_tracker_dist_CCQE;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_tracker_dist_Recoil;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_tracker_dist_Tejin;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_tracker_dist_Tejin_TrackerONLY;
-
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_tracker_Zdist_CCQE;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_tracker_Zdist_Recoil;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_tracker_Zdist_Tejin;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_tracker_Zdist_Tejin_TrackerONLY;
-
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_target_primary_parent_CCQE;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_target_primary_parent_Recoil;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_target_primary_parent_Tejin;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_target_primary_parent_Tejin_TrackerONLY;
-
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_target_length_CCQE;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_target_length_Recoil;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_target_length_Tejin;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_target_length_Tejin_TrackerONLY;
-
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_target_avg_dEdx_CCQE;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_target_avg_dEdx_Recoil;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_target_avg_dEdx_Tejin;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_target_avg_dEdx_Tejin_TrackerONLY;
-
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_target_blobE_CCQE;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_target_blobE_Recoil;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_target_blobE_Tejin;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_target_blobE_Tejin_TrackerONLY;
-
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_target_dist_CCQE;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_target_dist_Recoil;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_target_dist_Tejin;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_target_dist_Tejin_TrackerONLY;
-
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_target_Zdist_CCQE;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_target_Zdist_Recoil;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_target_Zdist_Tejin;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_target_Zdist_Tejin_TrackerONLY;
-
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_ALL_primary_parent_CCQE;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_ALL_primary_parent_Recoil;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_ALL_primary_parent_Tejin;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_ALL_primary_parent_Tejin_TrackerONLY;
-
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_ALL_length_CCQE;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_ALL_length_Recoil;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_ALL_length_Tejin;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_ALL_length_Tejin_TrackerONLY;
-
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_ALL_avg_dEdx_CCQE;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_ALL_avg_dEdx_Recoil;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_ALL_avg_dEdx_Tejin;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_ALL_avg_dEdx_Tejin_TrackerONLY;
-
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_ALL_blobE_CCQE;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_ALL_blobE_Recoil;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_ALL_blobE_Tejin;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_ALL_blobE_Tejin_TrackerONLY;
-
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_ALL_dist_CCQE;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_ALL_dist_Recoil;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_ALL_dist_Tejin;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_ALL_dist_Tejin_TrackerONLY;
-
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_ALL_Zdist_CCQE;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_ALL_Zdist_Recoil;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_ALL_Zdist_Tejin;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_ALL_Zdist_Tejin_TrackerONLY;
-
-  //Event Level Plots
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_leadBlob_primary_parent_CCQE;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_leadBlob_primary_parent_Recoil;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_leadBlob_primary_parent_Tejin;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_leadBlob_primary_parent_Tejin_TrackerONLY;
-
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_leadBlob_length_CCQE;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_leadBlob_length_Recoil;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_leadBlob_length_Tejin;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_leadBlob_length_Tejin_TrackerONLY;
-
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_leadBlob_avg_dEdx_CCQE;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_leadBlob_avg_dEdx_Recoil;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_leadBlob_avg_dEdx_Tejin;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_leadBlob_avg_dEdx_Tejin_TrackerONLY;
-
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_leadBlob_blobE_CCQE;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_leadBlob_blobE_Recoil;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_leadBlob_blobE_Tejin;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_leadBlob_blobE_Tejin_TrackerONLY;
-
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_leadBlob_dist_CCQE;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_leadBlob_dist_Recoil;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_leadBlob_dist_Tejin;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_leadBlob_dist_Tejin_TrackerONLY;
-
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_leadBlob_Zdist_CCQE;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_leadBlob_Zdist_Recoil;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_leadBlob_Zdist_Tejin;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_leadBlob_Zdist_Tejin_TrackerONLY;
-
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_leadBlob_passes_classifier_CCQE;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_leadBlob_passes_classifier_Recoil;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_leadBlob_passes_classifier_Tejin;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_leadBlob_passes_classifier_Tejin_TrackerONLY;
-
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_leadBlob_location_CCQE;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_leadBlob_location_Recoil;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_leadBlob_location_Tejin;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_leadBlob_location_Tejin_TrackerONLY;
-
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_n3DBlobs_CCQE;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_n3DBlobs_Recoil;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_n3DBlobs_Tejin;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_n3DBlobs_Tejin_TrackerONLY;
-
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_nGoodBlobs_CCQE;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_nGoodBlobs_Recoil;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_nGoodBlobs_Tejin;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_nGoodBlobs_Tejin_TrackerONLY;
-
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_nBlobs_CCQE;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_nBlobs_Recoil;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_nBlobs_Tejin;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_nBlobs_Tejin_TrackerONLY;
-
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_AvgBlobEnergy_CCQE;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_AvgBlobEnergy_Recoil;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_AvgBlobEnergy_Tejin;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_AvgBlobEnergy_Tejin_TrackerONLY;
-
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_RecoilEnergyGeV_CCQE;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_RecoilEnergyGeV_Recoil;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_RecoilEnergyGeV_Tejin;
-  map<int, PlotUtils::HistWrapper<CVUniverse>> map_hw_RecoilEnergyGeV_Tejin_TrackerONLY;
-
-  for(auto type: typeNames){
-    map_hw_tracker_primary_parent_CCQE[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_tracker_primary_parent_CCQE_"+type.second,"True "+type.second+" Primary Particle Matched To Blob (CCQE);;Blobs",10,0,10,error_bands);
-    map_hw_tracker_primary_parent_Recoil[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_tracker_primary_parent_Recoil_"+type.second,"True "+type.second+" Primary Particle Matched To Blob (CCQE, Recoil);;Blobs",10,0,10,error_bands);
-    map_hw_tracker_primary_parent_Tejin[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_tracker_primary_parent_Tejin_"+type.second,"True "+type.second+" Primary Particle Matched To Blob (CCQE, Recoil, Blob);;Blobs",10,0,10,error_bands);
-    map_hw_tracker_primary_parent_Tejin_TrackerONLY[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_tracker_primary_parent_Tejin_TrackerONLY_"+type.second,"True "+type.second+" Primary Particle Matched To Blob (CCQE, Recoil, Blob, Tracker Blob);;Blobs",10,0,10,error_bands);
-
-    map_hw_tracker_length_CCQE[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_tracker_length_CCQE_"+type.second,"True "+type.second+" Blob Length (CCQE);Len. [mm];Blobs",50,0,500,error_bands);
-    map_hw_tracker_length_Recoil[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_tracker_length_Recoil_"+type.second,"True "+type.second+" Blob Length (CCQE, Recoil);Len. [mm];Blobs",50,0,500,error_bands);
-    map_hw_tracker_length_Tejin[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_tracker_length_Tejin_"+type.second,"True "+type.second+" Blob Length (CCQE, Recoil, Blob);Len. [mm];Blobs",50,0,500,error_bands);
-    map_hw_tracker_length_Tejin_TrackerONLY[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_tracker_length_Tejin_TrackerONLY_"+type.second,"True "+type.second+" Blob Length (CCQE, Recoil, Blob, Tracker Blob);Len. [mm];Blobs",50,0,500,error_bands);
-
-    map_hw_tracker_avg_dEdx_CCQE[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_tracker_avg_dEdx_CCQE_"+type.second,"True "+type.second+" Blob Energy/Length (CCQE);dE/dx [MeV/mm];Blobs",25,0,50,error_bands);
-    map_hw_tracker_avg_dEdx_Recoil[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_tracker_avg_dEdx_Recoil_"+type.second,"True "+type.second+" Blob Energy/Length (CCQE, Recoil);dE/dx [MeV/mm];Blobs",25,0,50,error_bands);
-    map_hw_tracker_avg_dEdx_Tejin[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_tracker_avg_dEdx_Tejin_"+type.second,"True "+type.second+" Blob Energy/Length (CCQE, Recoil, Blob);dE/dx [MeV/mm];Blobs",25,0,50,error_bands);
-    map_hw_tracker_avg_dEdx_Tejin_TrackerONLY[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_tracker_avg_dEdx_Tejin_TrackerONLY_"+type.second,"True "+type.second+" Blob Energy/Length (CCQE, Recoil, Blob, Tracker Blob);dE/dx [MeV/mm];Blobs",25,0,50,error_bands);
-
-    map_hw_tracker_blobE_CCQE[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_tracker_blobE_CCQE_"+type.second,"True "+type.second+" Blob Energy (CCQE);E [MeV];Blobs",50,0,150,error_bands);
-    map_hw_tracker_blobE_Recoil[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_tracker_blobE_Recoil_"+type.second,"True "+type.second+" Blob Energy (CCQE, Recoil);E [MeV];Blobs",50,0,150,error_bands);
-    map_hw_tracker_blobE_Tejin[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_tracker_blobE_Tejin_"+type.second,"True "+type.second+" Blob Energy (CCQE, Recoil, Blob);E [MeV];Blobs",50,0,150,error_bands);
-    map_hw_tracker_blobE_Tejin_TrackerONLY[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_tracker_blobE_Tejin_TrackerONLY_"+type.second,"True "+type.second+" Blob Energy (CCQE, Recoil, Blob, Tracker Blob);E [MeV];Blobs",50,0,150,error_bands);
-
-    map_hw_tracker_dist_CCQE[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_tracker_dist_CCQE_"+type.second,"True "+type.second+" Blob Dist. To Vtx. (CCQE);Dist. [mm];Blobs",300,0,3000,error_bands);
-    map_hw_tracker_dist_Recoil[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_tracker_dist_Recoil_"+type.second,"True "+type.second+" Blob Dist. To Vtx. (CCQE, Recoil);Dist. [mm];Blobs",300,0,3000,error_bands);
-    map_hw_tracker_dist_Tejin[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_tracker_dist_Tejin_"+type.second,"True "+type.second+" Blob Dist. To Vtx. (CCQE, Recoil, Blob);Dist. [mm];Blobs",300,0,3000,error_bands);
-    map_hw_tracker_dist_Tejin_TrackerONLY[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_tracker_dist_Tejin_TrackerONLY_"+type.second,"True "+type.second+" Blob Dist. To Vtx. (CCQE, Recoil, Blob, Tracker Blob);Dist. [mm];Blobs",300,0,3000,error_bands);
-
-    map_hw_tracker_Zdist_CCQE[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_tracker_Zdist_CCQE_"+type.second,"True "+type.second+" Blob Absolute Z Dist. To Vtx. (CCQE);Dist. [mm];Blobs",300,0,3000,error_bands);
-    map_hw_tracker_Zdist_Recoil[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_tracker_Zdist_Recoil_"+type.second,"True "+type.second+" Blob Absolute Z Dist. To Vtx. (CCQE, Recoil);Dist. [mm];Blobs",300,0,3000,error_bands);
-    map_hw_tracker_Zdist_Tejin[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_tracker_Zdist_Tejin_"+type.second,"True "+type.second+" Blob Absolute Z Dist. To Vtx. (CCQE, Recoil, Blob);Dist. [mm];Blobs",300,0,3000,error_bands);
-    map_hw_tracker_Zdist_Tejin_TrackerONLY[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_tracker_Zdist_Tejin_TrackerONLY_"+type.second,"True "+type.second+" Blob Absolute Z Dist. To Vtx. (CCQE, Recoil, Blob, Tracker Blob);Dist. [mm];Blobs",300,0,3000,error_bands);
-
-    map_hw_target_primary_parent_CCQE[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_target_primary_parent_CCQE_"+type.second,"True "+type.second+" Primary Particle Matched To Blob (CCQE);;Blobs",10,0,10,error_bands);
-    map_hw_target_primary_parent_Recoil[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_target_primary_parent_Recoil_"+type.second,"True "+type.second+" Primary Particle Matched To Blob (CCQE, Recoil);;Blobs",10,0,10,error_bands);
-    map_hw_target_primary_parent_Tejin[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_target_primary_parent_Tejin_"+type.second,"True "+type.second+" Primary Particle Matched To Blob (CCQE, Recoil, Blob);;Blobs",10,0,10,error_bands);
-    map_hw_target_primary_parent_Tejin_TrackerONLY[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_target_primary_parent_Tejin_TrackerONLY_"+type.second,"True "+type.second+" Primary Particle Matched To Blob (CCQE, Recoil, Blob, Tracker Blob);;Blobs",10,0,10,error_bands);
-
-    map_hw_target_length_CCQE[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_target_length_CCQE_"+type.second,"True "+type.second+" Blob Length (CCQE);Len. [mm];Blobs",50,0,500,error_bands);
-    map_hw_target_length_Recoil[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_target_length_Recoil_"+type.second,"True "+type.second+" Blob Length (CCQE, Recoil);Len. [mm];Blobs",50,0,500,error_bands);
-    map_hw_target_length_Tejin[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_target_length_Tejin_"+type.second,"True "+type.second+" Blob Length (CCQE, Recoil, Blob);Len. [mm];Blobs",50,0,500,error_bands);
-    map_hw_target_length_Tejin_TrackerONLY[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_target_length_Tejin_TrackerONLY_"+type.second,"True "+type.second+" Blob Length (CCQE, Recoil, Blob, Tracker Blob);Len. [mm];Blobs",50,0,500,error_bands);
-
-    map_hw_target_avg_dEdx_CCQE[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_target_avg_dEdx_CCQE_"+type.second,"True "+type.second+" Blob Energy/Length (CCQE);dE/dx [MeV/mm];Blobs",25,0,50,error_bands);
-    map_hw_target_avg_dEdx_Recoil[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_target_avg_dEdx_Recoil_"+type.second,"True "+type.second+" Blob Energy/Length (CCQE, Recoil);dE/dx [MeV/mm];Blobs",25,0,50,error_bands);
-    map_hw_target_avg_dEdx_Tejin[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_target_avg_dEdx_Tejin_"+type.second,"True "+type.second+" Blob Energy/Length (CCQE, Recoil, Blob);dE/dx [MeV/mm];Blobs",25,0,50,error_bands);
-    map_hw_target_avg_dEdx_Tejin_TrackerONLY[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_target_avg_dEdx_Tejin_TrackerONLY_"+type.second,"True "+type.second+" Blob Energy/Length (CCQE, Recoil, Blob, Tracker Blob);dE/dx [MeV/mm];Blobs",25,0,50,error_bands);
-
-    map_hw_target_blobE_CCQE[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_target_blobE_CCQE_"+type.second,"True "+type.second+" Blob Energy (CCQE);E [MeV];Blobs",50,0,150,error_bands);
-    map_hw_target_blobE_Recoil[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_target_blobE_Recoil_"+type.second,"True "+type.second+" Blob Energy (CCQE, Recoil);E [MeV];Blobs",50,0,150,error_bands);
-    map_hw_target_blobE_Tejin[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_target_blobE_Tejin_"+type.second,"True "+type.second+" Blob Energy (CCQE, Recoil, Blob);E [MeV];Blobs",50,0,150,error_bands);
-    map_hw_target_blobE_Tejin_TrackerONLY[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_target_blobE_Tejin_TrackerONLY_"+type.second,"True "+type.second+" Blob Energy (CCQE, Recoil, Blob, Tracker Blob);E [MeV];Blobs",50,0,150,error_bands);
-
-    map_hw_target_dist_CCQE[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_target_dist_CCQE_"+type.second,"True "+type.second+" Blob Dist. To Vtx. (CCQE);Dist. [mm];Blobs",300,0,3000,error_bands);
-    map_hw_target_dist_Recoil[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_target_dist_Recoil_"+type.second,"True "+type.second+" Blob Dist. To Vtx. (CCQE, Recoil);Dist. [mm];Blobs",300,0,3000,error_bands);
-    map_hw_target_dist_Tejin[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_target_dist_Tejin_"+type.second,"True "+type.second+" Blob Dist. To Vtx. (CCQE, Recoil, Blob);Dist. [mm];Blobs",300,0,3000,error_bands);
-    map_hw_target_dist_Tejin_TrackerONLY[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_target_dist_Tejin_TrackerONLY_"+type.second,"True "+type.second+" Blob Dist. To Vtx. (CCQE, Recoil, Blob, Tracker Blob);Dist. [mm];Blobs",300,0,3000,error_bands);
-
-    map_hw_target_Zdist_CCQE[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_target_Zdist_CCQE_"+type.second,"True "+type.second+" Blob Absolute Z Dist. To Vtx. (CCQE);Dist. [mm];Blobs",300,0,3000,error_bands);
-    map_hw_target_Zdist_Recoil[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_target_Zdist_Recoil_"+type.second,"True "+type.second+" Blob Absolute Z Dist. To Vtx. (CCQE, Recoil);Dist. [mm];Blobs",300,0,3000,error_bands);
-    map_hw_target_Zdist_Tejin[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_target_Zdist_Tejin_"+type.second,"True "+type.second+" Blob Absolute Z Dist. To Vtx. (CCQE, Recoil, Blob);Dist. [mm];Blobs",300,0,3000,error_bands);
-    map_hw_target_Zdist_Tejin_TrackerONLY[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_target_Zdist_Tejin_TrackerONLY_"+type.second,"True "+type.second+" Blob Absolute Z Dist. To Vtx. (CCQE, Recoil, Blob, Tracker Blob);Dist. [mm];Blobs",300,0,3000,error_bands);
-
-    map_hw_ALL_primary_parent_CCQE[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_ALL_primary_parent_CCQE_"+type.second,"True "+type.second+" Primary Particle Matched To Blob (CCQE);;Blobs",10,0,10,error_bands);
-    map_hw_ALL_primary_parent_Recoil[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_ALL_primary_parent_Recoil_"+type.second,"True "+type.second+" Primary Particle Matched To Blob (CCQE, Recoil);;Blobs",10,0,10,error_bands);
-    map_hw_ALL_primary_parent_Tejin[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_ALL_primary_parent_Tejin_"+type.second,"True "+type.second+" Primary Particle Matched To Blob (CCQE, Recoil, Blob);;Blobs",10,0,10,error_bands);
-    map_hw_ALL_primary_parent_Tejin_TrackerONLY[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_ALL_primary_parent_Tejin_TrackerONLY_"+type.second,"True "+type.second+" Primary Particle Matched To Blob (CCQE, Recoil, Blob, Tracker Blob);;Blobs",10,0,10,error_bands);
-
-    map_hw_ALL_length_CCQE[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_ALL_length_CCQE_"+type.second,"True "+type.second+" Blob Length (CCQE);Len. [mm];Blobs",50,0,500,error_bands);
-    map_hw_ALL_length_Recoil[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_ALL_length_Recoil_"+type.second,"True "+type.second+" Blob Length (CCQE, Recoil);Len. [mm];Blobs",50,0,500,error_bands);
-    map_hw_ALL_length_Tejin[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_ALL_length_Tejin_"+type.second,"True "+type.second+" Blob Length (CCQE, Recoil, Blob);Len. [mm];Blobs",50,0,500,error_bands);
-    map_hw_ALL_length_Tejin_TrackerONLY[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_ALL_length_Tejin_TrackerONLY_"+type.second,"True "+type.second+" Blob Length (CCQE, Recoil, Blob, Tracker Blob);Len. [mm];Blobs",50,0,500,error_bands);
-
-    map_hw_ALL_avg_dEdx_CCQE[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_ALL_avg_dEdx_CCQE_"+type.second,"True "+type.second+" Blob Energy/Length (CCQE);dE/dx [MeV/mm];Blobs",25,0,50,error_bands);
-    map_hw_ALL_avg_dEdx_Recoil[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_ALL_avg_dEdx_Recoil_"+type.second,"True "+type.second+" Blob Energy/Length (CCQE, Recoil);dE/dx [MeV/mm];Blobs",25,0,50,error_bands);
-    map_hw_ALL_avg_dEdx_Tejin[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_ALL_avg_dEdx_Tejin_"+type.second,"True "+type.second+" Blob Energy/Length (CCQE, Recoil, Blob);dE/dx [MeV/mm];Blobs",25,0,50,error_bands);
-    map_hw_ALL_avg_dEdx_Tejin_TrackerONLY[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_ALL_avg_dEdx_Tejin_TrackerONLY_"+type.second,"True "+type.second+" Blob Energy/Length (CCQE, Recoil, Blob, Tracker Blob);dE/dx [MeV/mm];Blobs",25,0,50,error_bands);
-
-    map_hw_ALL_blobE_CCQE[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_ALL_blobE_CCQE_"+type.second,"True "+type.second+" Blob Energy (CCQE);E [MeV];Blobs",50,0,150,error_bands);
-    map_hw_ALL_blobE_Recoil[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_ALL_blobE_Recoil_"+type.second,"True "+type.second+" Blob Energy (CCQE, Recoil);E [MeV];Blobs",50,0,150,error_bands);
-    map_hw_ALL_blobE_Tejin[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_ALL_blobE_Tejin_"+type.second,"True "+type.second+" Blob Energy (CCQE, Recoil, Blob);E [MeV];Blobs",50,0,150,error_bands);
-    map_hw_ALL_blobE_Tejin_TrackerONLY[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_ALL_blobE_Tejin_TrackerONLY_"+type.second,"True "+type.second+" Blob Energy (CCQE, Recoil, Blob, Tracker Blob);E [MeV];Blobs",50,0,150,error_bands);
-
-    map_hw_ALL_dist_CCQE[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_ALL_dist_CCQE_"+type.second,"True "+type.second+" Blob Dist. To Vtx. (CCQE);Dist. [mm];Blobs",300,0,3000,error_bands);
-    map_hw_ALL_dist_Recoil[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_ALL_dist_Recoil_"+type.second,"True "+type.second+" Blob Dist. To Vtx. (CCQE, Recoil);Dist. [mm];Blobs",300,0,3000,error_bands);
-    map_hw_ALL_dist_Tejin[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_ALL_dist_Tejin_"+type.second,"True "+type.second+" Blob Dist. To Vtx. (CCQE, Recoil, Blob);Dist. [mm];Blobs",300,0,3000,error_bands);
-    map_hw_ALL_dist_Tejin_TrackerONLY[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_ALL_dist_Tejin_TrackerONLY_"+type.second,"True "+type.second+" Blob Dist. To Vtx. (CCQE, Recoil, Blob, Tracker Blob);Dist. [mm];Blobs",300,0,3000,error_bands);
-
-    map_hw_ALL_Zdist_CCQE[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_ALL_Zdist_CCQE_"+type.second,"True "+type.second+" Blob Absolute Z Dist. To Vtx. (CCQE);Dist. [mm];Blobs",300,0,3000,error_bands);
-    map_hw_ALL_Zdist_Recoil[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_ALL_Zdist_Recoil_"+type.second,"True "+type.second+" Blob Absolute Z Dist. To Vtx. (CCQE, Recoil);Dist. [mm];Blobs",300,0,3000,error_bands);
-    map_hw_ALL_Zdist_Tejin[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_ALL_Zdist_Tejin_"+type.second,"True "+type.second+" Blob Absolute Z Dist. To Vtx. (CCQE, Recoil, Blob);Dist. [mm];Blobs",300,0,3000,error_bands);
-    map_hw_ALL_Zdist_Tejin_TrackerONLY[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_ALL_Zdist_Tejin_TrackerONLY_"+type.second,"True "+type.second+" Blob Absolute Z Dist. To Vtx. (CCQE, Recoil, Blob, Tracker Blob);Dist. [mm];Blobs",300,0,3000,error_bands);
-
-    map_hw_leadBlob_primary_parent_CCQE[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_leadBlob_primary_parent_CCQE_"+type.second,"True "+type.second+" Primary Parent Matched To Leading Blob (CCQE);;Events",10,0,10,error_bands);
-    map_hw_leadBlob_primary_parent_Recoil[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_leadBlob_primary_parent_Recoil_"+type.second,"True "+type.second+" Primary Parent Matched To Leading Blob (CCQE, Recoil);;Events",10,0,10,error_bands);
-    map_hw_leadBlob_primary_parent_Tejin[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_leadBlob_primary_parent_Tejin_"+type.second,"True "+type.second+" Primary Parent Matched To Leading Blob (CCQE, Recoil, Blob);;Events",10,0,10,error_bands);
-    map_hw_leadBlob_primary_parent_Tejin_TrackerONLY[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_leadBlob_primary_parent_Tejin_TrackerONLY_"+type.second,"True "+type.second+" Primary Parent Matched To Leading Blob (CCQE, Recoil, Blob, Tracker Blob);;Events",10,0,10,error_bands);
-
-    map_hw_leadBlob_length_CCQE[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_leadBlob_length_CCQE_"+type.second,"True "+type.second+" Leading Blob Length (CCQE);Len. [mm];Events",50,0,500,error_bands);
-    map_hw_leadBlob_length_Recoil[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_leadBlob_length_Recoil_"+type.second,"True "+type.second+" Leading Blob Length (CCQE, Recoil);Len. [mm];Events",50,0,500,error_bands);
-    map_hw_leadBlob_length_Tejin[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_leadBlob_length_Tejin_"+type.second,"True "+type.second+" Leading Blob Length (CCQE, Recoil, Blob);Len. [mm];Events",50,0,500,error_bands);
-    map_hw_leadBlob_length_Tejin_TrackerONLY[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_leadBlob_length_Tejin_TrackerONLY_"+type.second,"True "+type.second+" Leading Blob Length (CCQE, Recoil, Blob, Tracker Blob);Len. [mm];Events",50,0,500,error_bands);
-
-    map_hw_leadBlob_avg_dEdx_CCQE[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_leadBlob_avg_dEdx_CCQE_"+type.second,"True "+type.second+" Leading Blob Energy/Length (CCQE);dE/dx [MeV/mm];Events",25,0,50,error_bands);
-    map_hw_leadBlob_avg_dEdx_Recoil[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_leadBlob_avg_dEdx_Recoil_"+type.second,"True "+type.second+" Leading Blob Energy/Length (CCQE, Recoil);dE/dx [MeV/mm];Events",25,0,50,error_bands);
-    map_hw_leadBlob_avg_dEdx_Tejin[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_leadBlob_avg_dEdx_Tejin_"+type.second,"True "+type.second+" Leading Blob Energy/Length (CCQE, Recoil, Blob);dE/dx [MeV/mm];Events",25,0,50,error_bands);
-    map_hw_leadBlob_avg_dEdx_Tejin_TrackerONLY[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_leadBlob_avg_dEdx_Tejin_TrackerONLY_"+type.second,"True "+type.second+" Leading Blob Energy/Length (CCQE, Recoil, Blob, Tracker Blob);dE/dx [MeV/mm];Events",25,0,50,error_bands);
-
-    map_hw_leadBlob_blobE_CCQE[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_leadBlob_blobE_CCQE_"+type.second,"True "+type.second+" Leading Blob Energy (CCQE);E [MeV];Events",50,0,150,error_bands);
-    map_hw_leadBlob_blobE_Recoil[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_leadBlob_blobE_Recoil_"+type.second,"True "+type.second+" Leading Blob Energy (CCQE, Recoil);E [MeV];Events",50,0,150,error_bands);
-    map_hw_leadBlob_blobE_Tejin[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_leadBlob_blobE_Tejin_"+type.second,"True "+type.second+" Leading Blob Energy (CCQE, Recoil, Blob);E [MeV];Events",50,0,150,error_bands);
-    map_hw_leadBlob_blobE_Tejin_TrackerONLY[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_leadBlob_blobE_Tejin_TrackerONLY_"+type.second,"True "+type.second+" Leading Blob Energy (CCQE, Recoil, Blob, Tracker Blob);E [MeV];Events",50,0,150,error_bands);
-
-    map_hw_leadBlob_dist_CCQE[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_leadBlob_dist_CCQE_"+type.second,"True "+type.second+" Leading Blob Dist. to Vtx (CCQE);Dist. [mm];Events",300,0,3000,error_bands);
-    map_hw_leadBlob_dist_Recoil[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_leadBlob_dist_Recoil_"+type.second,"True "+type.second+" Leading Blob Dist. to Vtx (CCQE, Recoil);Dist. [mm];Events",300,0,3000,error_bands);
-    map_hw_leadBlob_dist_Tejin[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_leadBlob_dist_Tejin_"+type.second,"True "+type.second+" Leading Blob Dist. to Vtx (CCQE, Recoil, Blob);Dist. [mm];Events",300,0,3000,error_bands);
-    map_hw_leadBlob_dist_Tejin_TrackerONLY[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_leadBlob_dist_Tejin_TrackerONLY_"+type.second,"True "+type.second+" Leading Blob Dist. to Vtx (CCQE, Recoil, Blob, Tracker Blob);Dist. [mm];Events",300,0,3000,error_bands);
-
-    map_hw_leadBlob_Zdist_CCQE[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_leadBlob_Zdist_CCQE_"+type.second,"True "+type.second+" Leading Blob Absolute Z Dist. to Vtx. (CCQE);Dist. [mm];Events",300,0,3000,error_bands);
-    map_hw_leadBlob_Zdist_Recoil[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_leadBlob_Zdist_Recoil_"+type.second,"True "+type.second+" Leading Blob Absolute Z Dist. to Vtx. (CCQE, Recoil);Dist. [mm];Events",300,0,3000,error_bands);
-    map_hw_leadBlob_Zdist_Tejin[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_leadBlob_Zdist_Tejin_"+type.second,"True "+type.second+" Leading Blob Absolute Z Dist. to Vtx. (CCQE, Recoil, Blob);Dist. [mm];Events",300,0,3000,error_bands);
-    map_hw_leadBlob_Zdist_Tejin_TrackerONLY[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_leadBlob_Zdist_Tejin_TrackerONLY_"+type.second,"True "+type.second+" Leading Blob Absolute Z Dist. to Vtx. (CCQE, Recoil, Blob, Tracker Blob);Dist. [mm];Events",300,0,3000,error_bands);
-
-    map_hw_leadBlob_passes_classifier_CCQE[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_leadBlob_passes_classifier_CCQE_"+type.second,"True "+type.second+" Leading Blob Passes (CCQE);;Events",2,0,2,error_bands);
-    map_hw_leadBlob_passes_classifier_Recoil[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_leadBlob_passes_classifier_Recoil_"+type.second,"True "+type.second+" Leading Blob Passes (CCQE, Recoil);;Events",2,0,2,error_bands);
-    map_hw_leadBlob_passes_classifier_Tejin[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_leadBlob_passes_classifier_Tejin_"+type.second,"True "+type.second+" Leading Blob Passes (CCQE, Recoil, Blob);;Events",2,0,2,error_bands);
-    map_hw_leadBlob_passes_classifier_Tejin_TrackerONLY[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_leadBlob_passes_classifier_Tejin_TrackerONLY_"+type.second,"True "+type.second+" Leading Blob Passes (CCQE, Recoil, Blob, Tracker Blob);;Events",2,0,2,error_bands);
-
-    map_hw_leadBlob_location_CCQE[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_leadBlob_location_CCQE_"+type.second,"True "+type.second+" Leading Blob Location (CCQE);;Events",2,0,2,error_bands);
-    map_hw_leadBlob_location_Recoil[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_leadBlob_location_Recoil_"+type.second,"True "+type.second+" Leading Blob Location (CCQE, Recoil);;Events",2,0,2,error_bands);
-    map_hw_leadBlob_location_Tejin[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_leadBlob_location_Tejin_"+type.second,"True "+type.second+" Leading Blob Location (CCQE, Recoil, Blob);;Events",2,0,2,error_bands);
-    map_hw_leadBlob_location_Tejin_TrackerONLY[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_leadBlob_location_Tejin_TrackerONLY_"+type.second,"True "+type.second+" Leading Blob Location (CCQE, Recoil, Blob, Tracker Blob);;Events",2,0,2,error_bands);
-
-    map_hw_n3DBlobs_CCQE[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_n3DBlobs_CCQE_"+type.second,"True "+type.second+" No. 3D Blobs (CCQE);No.;Events",10,0,10,error_bands);
-    map_hw_n3DBlobs_Recoil[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_n3DBlobs_Recoil_"+type.second,"True "+type.second+" No. 3D Blobs (CCQE, Recoil);No.;Events",10,0,10,error_bands);
-    map_hw_n3DBlobs_Tejin[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_n3DBlobs_Tejin_"+type.second,"True "+type.second+" No. 3D Blobs (CCQE, Recoil, Blob);No.;Events",10,0,10,error_bands);
-    map_hw_n3DBlobs_Tejin_TrackerONLY[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_n3DBlobs_Tejin_TrackerONLY_"+type.second,"True "+type.second+" No. 3D Blobs (CCQE, Recoil, Blob, Tracker Blob);No.;Events",10,0,10,error_bands);
-
-    map_hw_nGoodBlobs_CCQE[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_nGoodBlobs_CCQE_"+type.second,"True "+type.second+" No. Blobs Which Pass (CCQE);No.;Events",10,0,10,error_bands);
-    map_hw_nGoodBlobs_Recoil[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_nGoodBlobs_Recoil_"+type.second,"True "+type.second+" No. Blobs Which Pass (CCQE, Recoil);No.;Events",10,0,10,error_bands);
-    map_hw_nGoodBlobs_Tejin[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_nGoodBlobs_Tejin_"+type.second,"True "+type.second+" No. Blobs Which Pass (CCQE, Recoil, Blob);No.;Events",10,0,10,error_bands);
-    map_hw_nGoodBlobs_Tejin_TrackerONLY[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_nGoodBlobs_Tejin_TrackerONLY_"+type.second,"True "+type.second+" No. Blobs Which Pass (CCQE, Recoil, Blob, Tracker Blob);No.;Events",10,0,10,error_bands);
-
-    map_hw_nBlobs_CCQE[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_nBlobs_CCQE_"+type.second,"True "+type.second+" No. of Blobs (CCQE);No.;Events",100,0,100,error_bands);
-    map_hw_nBlobs_Recoil[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_nBlobs_Recoil_"+type.second,"True "+type.second+" No. of Blobs (CCQE, Recoil);No.;Events",100,0,100,error_bands);
-    map_hw_nBlobs_Tejin[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_nBlobs_Tejin_"+type.second,"True "+type.second+" No. of Blobs (CCQE, Recoil, Blob);No.;Events",100,0,100,error_bands);
-    map_hw_nBlobs_Tejin_TrackerONLY[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_nBlobs_Tejin_TrackerONLY_"+type.second,"True "+type.second+" No. of Blobs (CCQE, Recoil, Blob, Tracker Blob);No.;Events",100,0,100,error_bands);
-
-    map_hw_AvgBlobEnergy_CCQE[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_AvgBlobEnergy_CCQE_"+type.second,"True "+type.second+" Avg. Blob Energy (CCQE);Avg. E [MeV];Events",50,0,50,error_bands);
-    map_hw_AvgBlobEnergy_Recoil[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_AvgBlobEnergy_Recoil_"+type.second,"True "+type.second+" Avg. Blob Energy (CCQE, Recoil);Avg. E [MeV];Events",50,0,50,error_bands);
-    map_hw_AvgBlobEnergy_Tejin[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_AvgBlobEnergy_Tejin_"+type.second,"True "+type.second+" Avg. Blob Energy (CCQE, Recoil, Blob);Avg. E [MeV];Events",50,0,50,error_bands);
-    map_hw_AvgBlobEnergy_Tejin_TrackerONLY[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_AvgBlobEnergy_Tejin_TrackerONLY_"+type.second,"True "+type.second+" Avg. Blob Energy (CCQE, Recoil, Blob, Tracker Blob);Avg. E [MeV];Events",50,0,50,error_bands);
-
-    map_hw_RecoilEnergyGeV_CCQE[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_RecoilEnergyGeV_CCQE_"+type.second,"True "+type.second+" Recoil Energy (CCQE);RecoilE [GeV];Events",50,0,1.5,error_bands);
-    map_hw_RecoilEnergyGeV_Recoil[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_RecoilEnergyGeV_Recoil_"+type.second,"True "+type.second+" Recoil Energy (CCQE, Recoil);RecoilE [GeV];Events",50,0,1.5,error_bands);
-    map_hw_RecoilEnergyGeV_Tejin[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_RecoilEnergyGeV_Tejin_"+type.second,"True "+type.second+" Recoil Energy (CCQE, Recoil, Blob);RecoilE [GeV];Events",50,0,1.5,error_bands);
-    map_hw_RecoilEnergyGeV_Tejin_TrackerONLY[type.first]=PlotUtils::HistWrapper<CVUniverse>("hw_RecoilEnergyGeV_Tejin_TrackerONLY_"+type.second,"True "+type.second+" Recoil Energy (CCQE, Recoil, Blob, Tracker Blob);RecoilE [GeV];Events",50,0,1.5,error_bands);
+  if (nProcesses > 1){
+    if (playlist.find(txtExt) == string::npos){
+      cout << "--processes needs a .txt playlist to split." << endl;
+      return 3;
+    }
+    vector<string> childArgs(args.begin(), args.end());
+    childArgs.insert(childArgs.end(), childFlags.begin(), childFlags.end());
+    string outPrefix = "runEventLoop_sample_"+string(sampleNames[sample].Data())+"_region_"+string(regionNames[region].Data())+"_";
+    return RunFanOut(childArgs, nProcesses, playlist, playlistStub, outDir, outPrefix, tag, scanGrid, recordBranches);
   }
 
-  vector<PlotUtils::HistWrapper<CVUniverse>*> histsALL ={
-    &map_hw_tracker_primary_parent_CCQE[1],&map_hw_tracker_primary_parent_CCQE[2],&map_hw_tracker_primary_parent_CCQE[3],&map_hw_tracker_primary_parent_CCQE[8],&map_hw_tracker_primary_parent_CCQE[0],
-    &map_hw_tracker_primary_parent_Recoil[1],&map_hw_tracker_primary_parent_Recoil[2],&map_hw_tracker_primary_parent_Recoil[3],&map_hw_tracker_primary_parent_Recoil[8],&map_hw_tracker_primary_parent_Recoil[0],
-    &map_hw_tracker_primary_parent_Tejin[1],&map_hw_tracker_primary_parent_Tejin[2],&map_hw_tracker_primary_parent_Tejin[3],&map_hw_tracker_primary_parent_Tejin[8],&map_hw_tracker_primary_parent_Tejin[0],
-    &map_hw_tracker_primary_parent_Tejin_TrackerONLY[1],&map_hw_tracker_primary_parent_Tejin_TrackerONLY[2],&map_hw_tracker_primary_parent_Tejin_TrackerONLY[3],&map_hw_tracker_primary_parent_Tejin_TrackerONLY[8],&map_hw_tracker_primary_parent_Tejin_TrackerONLY[0],
-
-    &map_hw_tracker_length_CCQE[1],&map_hw_tracker_length_CCQE[2],&map_hw_tracker_length_CCQE[3],&map_hw_tracker_length_CCQE[8],&map_hw_tracker_length_CCQE[0],
-    &map_hw_tracker_length_Recoil[1],&map_hw_tracker_length_Recoil[2],&map_hw_tracker_length_Recoil[3],&map_hw_tracker_length_Recoil[8],&map_hw_tracker_length_Recoil[0],
-    &map_hw_tracker_length_Tejin[1],&map_hw_tracker_length_Tejin[2],&map_hw_tracker_length_Tejin[3],&map_hw_tracker_length_Tejin[8],&map_hw_tracker_length_Tejin[0],
-    &map_hw_tracker_length_Tejin_TrackerONLY[1],&map_hw_tracker_length_Tejin_TrackerONLY[2],&map_hw_tracker_length_Tejin_TrackerONLY[3],&map_hw_tracker_length_Tejin_TrackerONLY[8],&map_hw_tracker_length_Tejin_TrackerONLY[0],
-
-    &map_hw_tracker_avg_dEdx_CCQE[1],&map_hw_tracker_avg_dEdx_CCQE[2],&map_hw_tracker_avg_dEdx_CCQE[3],&map_hw_tracker_avg_dEdx_CCQE[8],&map_hw_tracker_avg_dEdx_CCQE[0],
-    &map_hw_tracker_avg_dEdx_Recoil[1],&map_hw_tracker_avg_dEdx_Recoil[2],&map_hw_tracker_avg_dEdx_Recoil[3],&map_hw_tracker_avg_dEdx_Recoil[8],&map_hw_tracker_avg_dEdx_Recoil[0],
-    &map_hw_tracker_avg_dEdx_Tejin[1],&map_hw_tracker_avg_dEdx_Tejin[2],&map_hw_tracker_avg_dEdx_Tejin[3],&map_hw_tracker_avg_dEdx_Tejin[8],&map_hw_tracker_avg_dEdx_Tejin[0],
-    &map_hw_tracker_avg_dEdx_Tejin_TrackerONLY[1],&map_hw_tracker_avg_dEdx_Tejin_TrackerONLY[2],&map_hw_tracker_avg_dEdx_Tejin_TrackerONLY[3],&map_hw_tracker_avg_dEdx_Tejin_TrackerONLY[8],&map_hw_tracker_avg_dEdx_Tejin_TrackerONLY[0],
-
-    &map_hw_tracker_blobE_CCQE[1],&map_hw_tracker_blobE_CCQE[2],&map_hw_tracker_blobE_CCQE[3],&map_hw_tracker_blobE_CCQE[8],&map_hw_tracker_blobE_CCQE[0],
-    &map_hw_tracker_blobE_Recoil[1],&map_hw_tracker_blobE_Recoil[2],&map_hw_tracker_blobE_Recoil[3],&map_hw_tracker_blobE_Recoil[8],&map_hw_tracker_blobE_Recoil[0],
-    &map_hw_tracker_blobE_Tejin[1],&map_hw_tracker_blobE_Tejin[2],&map_hw_tracker_blobE_Tejin[3],&map_hw_tracker_blobE_Tejin[8],&map_hw_tracker_blobE_Tejin[0],
-    &map_hw_tracker_blobE_Tejin_TrackerONLY[1],&map_hw_tracker_blobE_Tejin_TrackerONLY[2],&map_hw_tracker_blobE_Tejin_TrackerONLY[3],&map_hw_tracker_blobE_Tejin_TrackerONLY[8],&map_hw_tracker_blobE_Tejin_TrackerONLY[0],
-
-    &map_hw_tracker_dist_CCQE[1],&map_hw_tracker_dist_CCQE[2],&map_hw_tracker_dist_CCQE[3],&map_hw_tracker_dist_CCQE[8],&map_hw_tracker_dist_CCQE[0],
-    &map_hw_tracker_dist_Recoil[1],&map_hw_tracker_dist_Recoil[2],&map_hw_tracker_dist_Recoil[3],&map_hw_tracker_dist_Recoil[8],&map_hw_tracker_dist_Recoil[0],
-    &map_hw_tracker_dist_Tejin[1],&map_hw_tracker_dist_Tejin[2],&map_hw_tracker_dist_Tejin[3],&map_hw_tracker_dist_Tejin[8],&map_hw_tracker_dist_Tejin[0],
-    &map_hw_tracker_dist_Tejin_TrackerONLY[1],&map_hw_tracker_dist_Tejin_TrackerONLY[2],&map_hw_tracker_dist_Tejin_TrackerONLY[3],&map_hw_tracker_dist_Tejin_TrackerONLY[8],&map_hw_tracker_dist_Tejin_TrackerONLY[0],
-
-    &map_hw_tracker_Zdist_CCQE[1],&map_hw_tracker_Zdist_CCQE[2],&map_hw_tracker_Zdist_CCQE[3],&map_hw_tracker_Zdist_CCQE[8],&map_hw_tracker_Zdist_CCQE[0],
-    &map_hw_tracker_Zdist_Recoil[1],&map_hw_tracker_Zdist_Recoil[2],&map_hw_tracker_Zdist_Recoil[3],&map_hw_tracker_Zdist_Recoil[8],&map_hw_tracker_Zdist_Recoil[0],
-    &map_hw_tracker_Zdist_Tejin[1],&map_hw_tracker_Zdist_Tejin[2],&map_hw_tracker_Zdist_Tejin[3],&map_hw_tracker_Zdist_Tejin[8],&map_hw_tracker_Zdist_Tejin[0],
-    &map_hw_tracker_Zdist_Tejin_TrackerONLY[1],&map_hw_tracker_Zdist_Tejin_TrackerONLY[2],&map_hw_tracker_Zdist_Tejin_TrackerONLY[3],&map_hw_tracker_Zdist_Tejin_TrackerONLY[8],&map_hw_tracker_Zdist_Tejin_TrackerONLY[0],
-
-    &map_hw_target_primary_parent_CCQE[1],&map_hw_target_primary_parent_CCQE[2],&map_hw_target_primary_parent_CCQE[3],&map_hw_target_primary_parent_CCQE[8],&map_hw_target_primary_parent_CCQE[0],
-    &map_hw_target_primary_parent_Recoil[1],&map_hw_target_primary_parent_Recoil[2],&map_hw_target_primary_parent_Recoil[3],&map_hw_target_primary_parent_Recoil[8],&map_hw_target_primary_parent_Recoil[0],
-    &map_hw_target_primary_parent_Tejin[1],&map_hw_target_primary_parent_Tejin[2],&map_hw_target_primary_parent_Tejin[3],&map_hw_target_primary_parent_Tejin[8],&map_hw_target_primary_parent_Tejin[0],
-    &map_hw_target_primary_parent_Tejin_TrackerONLY[1],&map_hw_target_primary_parent_Tejin_TrackerONLY[2],&map_hw_target_primary_parent_Tejin_TrackerONLY[3],&map_hw_target_primary_parent_Tejin_TrackerONLY[8],&map_hw_target_primary_parent_Tejin_TrackerONLY[0],
-
-    &map_hw_target_length_CCQE[1],&map_hw_target_length_CCQE[2],&map_hw_target_length_CCQE[3],&map_hw_target_length_CCQE[8],&map_hw_target_length_CCQE[0],
-    &map_hw_target_length_Recoil[1],&map_hw_target_length_Recoil[2],&map_hw_target_length_Recoil[3],&map_hw_target_length_Recoil[8],&map_hw_target_length_Recoil[0],
-    &map_hw_target_length_Tejin[1],&map_hw_target_length_Tejin[2],&map_hw_target_length_Tejin[3],&map_hw_target_length_Tejin[8],&map_hw_target_length_Tejin[0],
-    &map_hw_target_length_Tejin_TrackerONLY[1],&map_hw_target_length_Tejin_TrackerONLY[2],&map_hw_target_length_Tejin_TrackerONLY[3],&map_hw_target_length_Tejin_TrackerONLY[8],&map_hw_target_length_Tejin_TrackerONLY[0],
-
-    &map_hw_target_avg_dEdx_CCQE[1],&map_hw_target_avg_dEdx_CCQE[2],&map_hw_target_avg_dEdx_CCQE[3],&map_hw_target_avg_dEdx_CCQE[8],&map_hw_target_avg_dEdx_CCQE[0],
-    &map_hw_target_avg_dEdx_Recoil[1],&map_hw_target_avg_dEdx_Recoil[2],&map_hw_target_avg_dEdx_Recoil[3],&map_hw_target_avg_dEdx_Recoil[8],&map_hw_target_avg_dEdx_Recoil[0],
-    &map_hw_target_avg_dEdx_Tejin[1],&map_hw_target_avg_dEdx_Tejin[2],&map_hw_target_avg_dEdx_Tejin[3],&map_hw_target_avg_dEdx_Tejin[8],&map_hw_target_avg_dEdx_Tejin[0],
-    &map_hw_target_avg_dEdx_Tejin_TrackerONLY[1],&map_hw_target_avg_dEdx_Tejin_TrackerONLY[2],&map_hw_target_avg_dEdx_Tejin_TrackerONLY[3],&map_hw_target_avg_dEdx_Tejin_TrackerONLY[8],&map_hw_target_avg_dEdx_Tejin_TrackerONLY[0],
-
-    &map_hw_target_blobE_CCQE[1],&map_hw_target_blobE_CCQE[2],&map_hw_target_blobE_CCQE[3],&map_hw_target_blobE_CCQE[8],&map_hw_target_blobE_CCQE[0],
-    &map_hw_target_blobE_Recoil[1],&map_hw_target_blobE_Recoil[2],&map_hw_target_blobE_Recoil[3],&map_hw_target_blobE_Recoil[8],&map_hw_target_blobE_Recoil[0],
-    &map_hw_target_blobE_Tejin[1],&map_hw_target_blobE_Tejin[2],&map_hw_target_blobE_Tejin[3],&map_hw_target_blobE_Tejin[8],&map_hw_target_blobE_Tejin[0],
-    &map_hw_target_blobE_Tejin_TrackerONLY[1],&map_hw_target_blobE_Tejin_TrackerONLY[2],&map_hw_target_blobE_Tejin_TrackerONLY[3],&map_hw_target_blobE_Tejin_TrackerONLY[8],&map_hw_target_blobE_Tejin_TrackerONLY[0],
-
-    &map_hw_target_dist_CCQE[1],&map_hw_target_dist_CCQE[2],&map_hw_target_dist_CCQE[3],&map_hw_target_dist_CCQE[8],&map_hw_target_dist_CCQE[0],
-    &map_hw_target_dist_Recoil[1],&map_hw_target_dist_Recoil[2],&map_hw_target_dist_Recoil[3],&map_hw_target_dist_Recoil[8],&map_hw_target_dist_Recoil[0],
-    &map_hw_target_dist_Tejin[1],&map_hw_target_dist_Tejin[2],&map_hw_target_dist_Tejin[3],&map_hw_target_dist_Tejin[8],&map_hw_target_dist_Tejin[0],
-    &map_hw_target_dist_Tejin_TrackerONLY[1],&map_hw_target_dist_Tejin_TrackerONLY[2],&map_hw_target_dist_Tejin_TrackerONLY[3],&map_hw_target_dist_Tejin_TrackerONLY[8],&map_hw_target_dist_Tejin_TrackerONLY[0],
-
-    &map_hw_target_Zdist_CCQE[1],&map_hw_target_Zdist_CCQE[2],&map_hw_target_Zdist_CCQE[3],&map_hw_target_Zdist_CCQE[8],&map_hw_target_Zdist_CCQE[0],
-    &map_hw_target_Zdist_Recoil[1],&map_hw_target_Zdist_Recoil[2],&map_hw_target_Zdist_Recoil[3],&map_hw_target_Zdist_Recoil[8],&map_hw_target_Zdist_Recoil[0],
-    &map_hw_target_Zdist_Tejin[1],&map_hw_target_Zdist_Tejin[2],&map_hw_target_Zdist_Tejin[3],&map_hw_target_Zdist_Tejin[8],&map_hw_target_Zdist_Tejin[0],
-    &map_hw_target_Zdist_Tejin_TrackerONLY[1],&map_hw_target_Zdist_Tejin_TrackerONLY[2],&map_hw_target_Zdist_Tejin_TrackerONLY[3],&map_hw_target_Zdist_Tejin_TrackerONLY[8],&map_hw_target_Zdist_Tejin_TrackerONLY[0],
-
-    &map_hw_ALL_primary_parent_CCQE[1],&map_hw_ALL_primary_parent_CCQE[2],&map_hw_ALL_primary_parent_CCQE[3],&map_hw_ALL_primary_parent_CCQE[8],&map_hw_ALL_primary_parent_CCQE[0],
-    &map_hw_ALL_primary_parent_Recoil[1],&map_hw_ALL_primary_parent_Recoil[2],&map_hw_ALL_primary_parent_Recoil[3],&map_hw_ALL_primary_parent_Recoil[8],&map_hw_ALL_primary_parent_Recoil[0],
-    &map_hw_ALL_primary_parent_Tejin[1],&map_hw_ALL_primary_parent_Tejin[2],&map_hw_ALL_primary_parent_Tejin[3],&map_hw_ALL_primary_parent_Tejin[8],&map_hw_ALL_primary_parent_Tejin[0],
-    &map_hw_ALL_primary_parent_Tejin_TrackerONLY[1],&map_hw_ALL_primary_parent_Tejin_TrackerONLY[2],&map_hw_ALL_primary_parent_Tejin_TrackerONLY[3],&map_hw_ALL_primary_parent_Tejin_TrackerONLY[8],&map_hw_ALL_primary_parent_Tejin_TrackerONLY[0],
-
-    &map_hw_ALL_length_CCQE[1],&map_hw_ALL_length_CCQE[2],&map_hw_ALL_length_CCQE[3],&map_hw_ALL_length_CCQE[8],&map_hw_ALL_length_CCQE[0],
-    &map_hw_ALL_length_Recoil[1],&map_hw_ALL_length_Recoil[2],&map_hw_ALL_length_Recoil[3],&map_hw_ALL_length_Recoil[8],&map_hw_ALL_length_Recoil[0],
-    &map_hw_ALL_length_Tejin[1],&map_hw_ALL_length_Tejin[2],&map_hw_ALL_length_Tejin[3],&map_hw_ALL_length_Tejin[8],&map_hw_ALL_length_Tejin[0],
-    &map_hw_ALL_length_Tejin_TrackerONLY[1],&map_hw_ALL_length_Tejin_TrackerONLY[2],&map_hw_ALL_length_Tejin_TrackerONLY[3],&map_hw_ALL_length_Tejin_TrackerONLY[8],&map_hw_ALL_length_Tejin_TrackerONLY[0],
-
-    &map_hw_ALL_avg_dEdx_CCQE[1],&map_hw_ALL_avg_dEdx_CCQE[2],&map_hw_ALL_avg_dEdx_CCQE[3],&map_hw_ALL_avg_dEdx_CCQE[8],&map_hw_ALL_avg_dEdx_CCQE[0],
-    &map_hw_ALL_avg_dEdx_Recoil[1],&map_hw_ALL_avg_dEdx_Recoil[2],&map_hw_ALL_avg_dEdx_Recoil[3],&map_hw_ALL_avg_dEdx_Recoil[8],&map_hw_ALL_avg_dEdx_Recoil[0],
-    &map_hw_ALL_avg_dEdx_Tejin[1],&map_hw_ALL_avg_dEdx_Tejin[2],&map_hw_ALL_avg_dEdx_Tejin[3],&map_hw_ALL_avg_dEdx_Tejin[8],&map_hw_ALL_avg_dEdx_Tejin[0],
-    &map_hw_ALL_avg_dEdx_Tejin_TrackerONLY[1],&map_hw_ALL_avg_dEdx_Tejin_TrackerONLY[2],&map_hw_ALL_avg_dEdx_Tejin_TrackerONLY[3],&map_hw_ALL_avg_dEdx_Tejin_TrackerONLY[8],&map_hw_ALL_avg_dEdx_Tejin_TrackerONLY[0],
-
-    &map_hw_ALL_blobE_CCQE[1],&map_hw_ALL_blobE_CCQE[2],&map_hw_ALL_blobE_CCQE[3],&map_hw_ALL_blobE_CCQE[8],&map_hw_ALL_blobE_CCQE[0],
-    &map_hw_ALL_blobE_Recoil[1],&map_hw_ALL_blobE_Recoil[2],&map_hw_ALL_blobE_Recoil[3],&map_hw_ALL_blobE_Recoil[8],&map_hw_ALL_blobE_Recoil[0],
-    &map_hw_ALL_blobE_Tejin[1],&map_hw_ALL_blobE_Tejin[2],&map_hw_ALL_blobE_Tejin[3],&map_hw_ALL_blobE_Tejin[8],&map_hw_ALL_blobE_Tejin[0],
-    &map_hw_ALL_blobE_Tejin_TrackerONLY[1],&map_hw_ALL_blobE_Tejin_TrackerONLY[2],&map_hw_ALL_blobE_Tejin_TrackerONLY[3],&map_hw_ALL_blobE_Tejin_TrackerONLY[8],&map_hw_ALL_blobE_Tejin_TrackerONLY[0],
-
-    &map_hw_ALL_dist_CCQE[1],&map_hw_ALL_dist_CCQE[2],&map_hw_ALL_dist_CCQE[3],&map_hw_ALL_dist_CCQE[8],&map_hw_ALL_dist_CCQE[0],
-    &map_hw_ALL_dist_Recoil[1],&map_hw_ALL_dist_Recoil[2],&map_hw_ALL_dist_Recoil[3],&map_hw_ALL_dist_Recoil[8],&map_hw_ALL_dist_Recoil[0],
-    &map_hw_ALL_dist_Tejin[1],&map_hw_ALL_dist_Tejin[2],&map_hw_ALL_dist_Tejin[3],&map_hw_ALL_dist_Tejin[8],&map_hw_ALL_dist_Tejin[0],
-    &map_hw_ALL_dist_Tejin_TrackerONLY[1],&map_hw_ALL_dist_Tejin_TrackerONLY[2],&map_hw_ALL_dist_Tejin_TrackerONLY[3],&map_hw_ALL_dist_Tejin_TrackerONLY[8],&map_hw_ALL_dist_Tejin_TrackerONLY[0],
-
-    &map_hw_ALL_Zdist_CCQE[1],&map_hw_ALL_Zdist_CCQE[2],&map_hw_ALL_Zdist_CCQE[3],&map_hw_ALL_Zdist_CCQE[8],&map_hw_ALL_Zdist_CCQE[0],
-    &map_hw_ALL_Zdist_Recoil[1],&map_hw_ALL_Zdist_Recoil[2],&map_hw_ALL_Zdist_Recoil[3],&map_hw_ALL_Zdist_Recoil[8],&map_hw_ALL_Zdist_Recoil[0],
-    &map_hw_ALL_Zdist_Tejin[1],&map_hw_ALL_Zdist_Tejin[2],&map_hw_ALL_Zdist_Tejin[3],&map_hw_ALL_Zdist_Tejin[8],&map_hw_ALL_Zdist_Tejin[0],
-    &map_hw_ALL_Zdist_Tejin_TrackerONLY[1],&map_hw_ALL_Zdist_Tejin_TrackerONLY[2],&map_hw_ALL_Zdist_Tejin_TrackerONLY[3],&map_hw_ALL_Zdist_Tejin_TrackerONLY[8],&map_hw_ALL_Zdist_Tejin_TrackerONLY[0],
-
-    &map_hw_leadBlob_primary_parent_CCQE[1],&map_hw_leadBlob_primary_parent_CCQE[2],&map_hw_leadBlob_primary_parent_CCQE[3],&map_hw_leadBlob_primary_parent_CCQE[8],&map_hw_leadBlob_primary_parent_CCQE[0],
-    &map_hw_leadBlob_primary_parent_Recoil[1],&map_hw_leadBlob_primary_parent_Recoil[2],&map_hw_leadBlob_primary_parent_Recoil[3],&map_hw_leadBlob_primary_parent_Recoil[8],&map_hw_leadBlob_primary_parent_Recoil[0],
-    &map_hw_leadBlob_primary_parent_Tejin[1],&map_hw_leadBlob_primary_parent_Tejin[2],&map_hw_leadBlob_primary_parent_Tejin[3],&map_hw_leadBlob_primary_parent_Tejin[8],&map_hw_leadBlob_primary_parent_Tejin[0],
-    &map_hw_leadBlob_primary_parent_Tejin_TrackerONLY[1],&map_hw_leadBlob_primary_parent_Tejin_TrackerONLY[2],&map_hw_leadBlob_primary_parent_Tejin_TrackerONLY[3],&map_hw_leadBlob_primary_parent_Tejin_TrackerONLY[8],&map_hw_leadBlob_primary_parent_Tejin_TrackerONLY[0],
-
-    &map_hw_leadBlob_length_CCQE[1],&map_hw_leadBlob_length_CCQE[2],&map_hw_leadBlob_length_CCQE[3],&map_hw_leadBlob_length_CCQE[8],&map_hw_leadBlob_length_CCQE[0],
-    &map_hw_leadBlob_length_Recoil[1],&map_hw_leadBlob_length_Recoil[2],&map_hw_leadBlob_length_Recoil[3],&map_hw_leadBlob_length_Recoil[8],&map_hw_leadBlob_length_Recoil[0],
-    &map_hw_leadBlob_length_Tejin[1],&map_hw_leadBlob_length_Tejin[2],&map_hw_leadBlob_length_Tejin[3],&map_hw_leadBlob_length_Tejin[8],&map_hw_leadBlob_length_Tejin[0],
-    &map_hw_leadBlob_length_Tejin_TrackerONLY[1],&map_hw_leadBlob_length_Tejin_TrackerONLY[2],&map_hw_leadBlob_length_Tejin_TrackerONLY[3],&map_hw_leadBlob_length_Tejin_TrackerONLY[8],&map_hw_leadBlob_length_Tejin_TrackerONLY[0],
-
-    &map_hw_leadBlob_avg_dEdx_CCQE[1],&map_hw_leadBlob_avg_dEdx_CCQE[2],&map_hw_leadBlob_avg_dEdx_CCQE[3],&map_hw_leadBlob_avg_dEdx_CCQE[8],&map_hw_leadBlob_avg_dEdx_CCQE[0],
-    &map_hw_leadBlob_avg_dEdx_Recoil[1],&map_hw_leadBlob_avg_dEdx_Recoil[2],&map_hw_leadBlob_avg_dEdx_Recoil[3],&map_hw_leadBlob_avg_dEdx_Recoil[8],&map_hw_leadBlob_avg_dEdx_Recoil[0],
-    &map_hw_leadBlob_avg_dEdx_Tejin[1],&map_hw_leadBlob_avg_dEdx_Tejin[2],&map_hw_leadBlob_avg_dEdx_Tejin[3],&map_hw_leadBlob_avg_dEdx_Tejin[8],&map_hw_leadBlob_avg_dEdx_Tejin[0],
-    &map_hw_leadBlob_avg_dEdx_Tejin_TrackerONLY[1],&map_hw_leadBlob_avg_dEdx_Tejin_TrackerONLY[2],&map_hw_leadBlob_avg_dEdx_Tejin_TrackerONLY[3],&map_hw_leadBlob_avg_dEdx_Tejin_TrackerONLY[8],&map_hw_leadBlob_avg_dEdx_Tejin_TrackerONLY[0],
-
-    &map_hw_leadBlob_blobE_CCQE[1],&map_hw_leadBlob_blobE_CCQE[2],&map_hw_leadBlob_blobE_CCQE[3],&map_hw_leadBlob_blobE_CCQE[8],&map_hw_leadBlob_blobE_CCQE[0],
-    &map_hw_leadBlob_blobE_Recoil[1],&map_hw_leadBlob_blobE_Recoil[2],&map_hw_leadBlob_blobE_Recoil[3],&map_hw_leadBlob_blobE_Recoil[8],&map_hw_leadBlob_blobE_Recoil[0],
-    &map_hw_leadBlob_blobE_Tejin[1],&map_hw_leadBlob_blobE_Tejin[2],&map_hw_leadBlob_blobE_Tejin[3],&map_hw_leadBlob_blobE_Tejin[8],&map_hw_leadBlob_blobE_Tejin[0],
-    &map_hw_leadBlob_blobE_Tejin_TrackerONLY[1],&map_hw_leadBlob_blobE_Tejin_TrackerONLY[2],&map_hw_leadBlob_blobE_Tejin_TrackerONLY[3],&map_hw_leadBlob_blobE_Tejin_TrackerONLY[8],&map_hw_leadBlob_blobE_Tejin_TrackerONLY[0],
-
-    &map_hw_leadBlob_dist_CCQE[1],&map_hw_leadBlob_dist_CCQE[2],&map_hw_leadBlob_dist_CCQE[3],&map_hw_leadBlob_dist_CCQE[8],&map_hw_leadBlob_dist_CCQE[0],
-    &map_hw_leadBlob_dist_Recoil[1],&map_hw_leadBlob_dist_Recoil[2],&map_hw_leadBlob_dist_Recoil[3],&map_hw_leadBlob_dist_Recoil[8],&map_hw_leadBlob_dist_Recoil[0],
-    &map_hw_leadBlob_dist_Tejin[1],&map_hw_leadBlob_dist_Tejin[2],&map_hw_leadBlob_dist_Tejin[3],&map_hw_leadBlob_dist_Tejin[8],&map_hw_leadBlob_dist_Tejin[0],
-    &map_hw_leadBlob_dist_Tejin_TrackerONLY[1],&map_hw_leadBlob_dist_Tejin_TrackerONLY[2],&map_hw_leadBlob_dist_Tejin_TrackerONLY[3],&map_hw_leadBlob_dist_Tejin_TrackerONLY[8],&map_hw_leadBlob_dist_Tejin_TrackerONLY[0],
-
-    &map_hw_leadBlob_Zdist_CCQE[1],&map_hw_leadBlob_Zdist_CCQE[2],&map_hw_leadBlob_Zdist_CCQE[3],&map_hw_leadBlob_Zdist_CCQE[8],&map_hw_leadBlob_Zdist_CCQE[0],
-    &map_hw_leadBlob_Zdist_Recoil[1],&map_hw_leadBlob_Zdist_Recoil[2],&map_hw_leadBlob_Zdist_Recoil[3],&map_hw_leadBlob_Zdist_Recoil[8],&map_hw_leadBlob_Zdist_Recoil[0],
-    &map_hw_leadBlob_Zdist_Tejin[1],&map_hw_leadBlob_Zdist_Tejin[2],&map_hw_leadBlob_Zdist_Tejin[3],&map_hw_leadBlob_Zdist_Tejin[8],&map_hw_leadBlob_Zdist_Tejin[0],
-    &map_hw_leadBlob_Zdist_Tejin_TrackerONLY[1],&map_hw_leadBlob_Zdist_Tejin_TrackerONLY[2],&map_hw_leadBlob_Zdist_Tejin_TrackerONLY[3],&map_hw_leadBlob_Zdist_Tejin_TrackerONLY[8],&map_hw_leadBlob_Zdist_Tejin_TrackerONLY[0],
-
-    &map_hw_leadBlob_passes_classifier_CCQE[1],&map_hw_leadBlob_passes_classifier_CCQE[2],&map_hw_leadBlob_passes_classifier_CCQE[3],&map_hw_leadBlob_passes_classifier_CCQE[8],&map_hw_leadBlob_passes_classifier_CCQE[0],
-    &map_hw_leadBlob_passes_classifier_Recoil[1],&map_hw_leadBlob_passes_classifier_Recoil[2],&map_hw_leadBlob_passes_classifier_Recoil[3],&map_hw_leadBlob_passes_classifier_Recoil[8],&map_hw_leadBlob_passes_classifier_Recoil[0],
-    &map_hw_leadBlob_passes_classifier_Tejin[1],&map_hw_leadBlob_passes_classifier_Tejin[2],&map_hw_leadBlob_passes_classifier_Tejin[3],&map_hw_leadBlob_passes_classifier_Tejin[8],&map_hw_leadBlob_passes_classifier_Tejin[0],
-    &map_hw_leadBlob_passes_classifier_Tejin_TrackerONLY[1],&map_hw_leadBlob_passes_classifier_Tejin_TrackerONLY[2],&map_hw_leadBlob_passes_classifier_Tejin_TrackerONLY[3],&map_hw_leadBlob_passes_classifier_Tejin_TrackerONLY[8],&map_hw_leadBlob_passes_classifier_Tejin_TrackerONLY[0],
-
-    &map_hw_leadBlob_location_CCQE[1],&map_hw_leadBlob_location_CCQE[2],&map_hw_leadBlob_location_CCQE[3],&map_hw_leadBlob_location_CCQE[8],&map_hw_leadBlob_location_CCQE[0],
-    &map_hw_leadBlob_location_Recoil[1],&map_hw_leadBlob_location_Recoil[2],&map_hw_leadBlob_location_Recoil[3],&map_hw_leadBlob_location_Recoil[8],&map_hw_leadBlob_location_Recoil[0],
-    &map_hw_leadBlob_location_Tejin[1],&map_hw_leadBlob_location_Tejin[2],&map_hw_leadBlob_location_Tejin[3],&map_hw_leadBlob_location_Tejin[8],&map_hw_leadBlob_location_Tejin[0],
-    &map_hw_leadBlob_location_Tejin_TrackerONLY[1],&map_hw_leadBlob_location_Tejin_TrackerONLY[2],&map_hw_leadBlob_location_Tejin_TrackerONLY[3],&map_hw_leadBlob_location_Tejin_TrackerONLY[8],&map_hw_leadBlob_location_Tejin_TrackerONLY[0],
-
-    &map_hw_n3DBlobs_CCQE[1],&map_hw_n3DBlobs_CCQE[2],&map_hw_n3DBlobs_CCQE[3],&map_hw_n3DBlobs_CCQE[8],&map_hw_n3DBlobs_CCQE[0],
-    &map_hw_n3DBlobs_Recoil[1],&map_hw_n3DBlobs_Recoil[2],&map_hw_n3DBlobs_Recoil[3],&map_hw_n3DBlobs_Recoil[8],&map_hw_n3DBlobs_Recoil[0],
-    &map_hw_n3DBlobs_Tejin[1],&map_hw_n3DBlobs_Tejin[2],&map_hw_n3DBlobs_Tejin[3],&map_hw_n3DBlobs_Tejin[8],&map_hw_n3DBlobs_Tejin[0],
-    &map_hw_n3DBlobs_Tejin_TrackerONLY[1],&map_hw_n3DBlobs_Tejin_TrackerONLY[2],&map_hw_n3DBlobs_Tejin_TrackerONLY[3],&map_hw_n3DBlobs_Tejin_TrackerONLY[8],&map_hw_n3DBlobs_Tejin_TrackerONLY[0],
-
-    &map_hw_nGoodBlobs_CCQE[1],&map_hw_nGoodBlobs_CCQE[2],&map_hw_nGoodBlobs_CCQE[3],&map_hw_nGoodBlobs_CCQE[8],&map_hw_nGoodBlobs_CCQE[0],
-    &map_hw_nGoodBlobs_Recoil[1],&map_hw_nGoodBlobs_Recoil[2],&map_hw_nGoodBlobs_Recoil[3],&map_hw_nGoodBlobs_Recoil[8],&map_hw_nGoodBlobs_Recoil[0],
-    &map_hw_nGoodBlobs_Tejin[1],&map_hw_nGoodBlobs_Tejin[2],&map_hw_nGoodBlobs_Tejin[3],&map_hw_nGoodBlobs_Tejin[8],&map_hw_nGoodBlobs_Tejin[0],
-    &map_hw_nGoodBlobs_Tejin_TrackerONLY[1],&map_hw_nGoodBlobs_Tejin_TrackerONLY[2],&map_hw_nGoodBlobs_Tejin_TrackerONLY[3],&map_hw_nGoodBlobs_Tejin_TrackerONLY[8],&map_hw_nGoodBlobs_Tejin_TrackerONLY[0],
-
-    &map_hw_nBlobs_CCQE[1],&map_hw_nBlobs_CCQE[2],&map_hw_nBlobs_CCQE[3],&map_hw_nBlobs_CCQE[8],&map_hw_nBlobs_CCQE[0],
-    &map_hw_nBlobs_Recoil[1],&map_hw_nBlobs_Recoil[2],&map_hw_nBlobs_Recoil[3],&map_hw_nBlobs_Recoil[8],&map_hw_nBlobs_Recoil[0],
-    &map_hw_nBlobs_Tejin[1],&map_hw_nBlobs_Tejin[2],&map_hw_nBlobs_Tejin[3],&map_hw_nBlobs_Tejin[8],&map_hw_nBlobs_Tejin[0],
-    &map_hw_nBlobs_Tejin_TrackerONLY[1],&map_hw_nBlobs_Tejin_TrackerONLY[2],&map_hw_nBlobs_Tejin_TrackerONLY[3],&map_hw_nBlobs_Tejin_TrackerONLY[8],&map_hw_nBlobs_Tejin_TrackerONLY[0],
-
-    &map_hw_AvgBlobEnergy_CCQE[1],&map_hw_AvgBlobEnergy_CCQE[2],&map_hw_AvgBlobEnergy_CCQE[3],&map_hw_AvgBlobEnergy_CCQE[8],&map_hw_AvgBlobEnergy_CCQE[0],
-    &map_hw_AvgBlobEnergy_Recoil[1],&map_hw_AvgBlobEnergy_Recoil[2],&map_hw_AvgBlobEnergy_Recoil[3],&map_hw_AvgBlobEnergy_Recoil[8],&map_hw_AvgBlobEnergy_Recoil[0],
-    &map_hw_AvgBlobEnergy_Tejin[1],&map_hw_AvgBlobEnergy_Tejin[2],&map_hw_AvgBlobEnergy_Tejin[3],&map_hw_AvgBlobEnergy_Tejin[8],&map_hw_AvgBlobEnergy_Tejin[0],
-    &map_hw_AvgBlobEnergy_Tejin_TrackerONLY[1],&map_hw_AvgBlobEnergy_Tejin_TrackerONLY[2],&map_hw_AvgBlobEnergy_Tejin_TrackerONLY[3],&map_hw_AvgBlobEnergy_Tejin_TrackerONLY[8],&map_hw_AvgBlobEnergy_Tejin_TrackerONLY[0],
-
-    &map_hw_RecoilEnergyGeV_CCQE[1],&map_hw_RecoilEnergyGeV_CCQE[2],&map_hw_RecoilEnergyGeV_CCQE[3],&map_hw_RecoilEnergyGeV_CCQE[8],&map_hw_RecoilEnergyGeV_CCQE[0],
-    &map_hw_RecoilEnergyGeV_Recoil[1],&map_hw_RecoilEnergyGeV_Recoil[2],&map_hw_RecoilEnergyGeV_Recoil[3],&map_hw_RecoilEnergyGeV_Recoil[8],&map_hw_RecoilEnergyGeV_Recoil[0],
-    &map_hw_RecoilEnergyGeV_Tejin[1],&map_hw_RecoilEnergyGeV_Tejin[2],&map_hw_RecoilEnergyGeV_Tejin[3],&map_hw_RecoilEnergyGeV_Tejin[8],&map_hw_RecoilEnergyGeV_Tejin[0],
-    &map_hw_RecoilEnergyGeV_Tejin_TrackerONLY[1],&map_hw_RecoilEnergyGeV_Tejin_TrackerONLY[2],&map_hw_RecoilEnergyGeV_Tejin_TrackerONLY[3],&map_hw_RecoilEnergyGeV_Tejin_TrackerONLY[8],&map_hw_RecoilEnergyGeV_Tejin_TrackerONLY[0]
-  };
 
-  if(nEntries <= 0) nEntries = chain->GetEntries();
-  cout << "Processing " << nEntries << " events." << endl;
-  int n3DBlobs=0;
-  int nGoodBlobs=0;
-  double blobESum=0.0;
-  for (int i=0; i<nEntries;++i){
-    if (i%(nEntries/100)==0) cout << (100*i)/nEntries << "% finished." << endl;
-    //if (i%(10000)==0) cout << i << " entries finished." << endl;
-    for (auto band : error_bands){
-      vector<CVUniverse*> error_band_universes = band.second;
-      for (auto universe : error_band_universes){
-	n3DBlobs=0;
-	nGoodBlobs=0;
-	blobESum=0.0;
-	universe->SetEntry(i);
-	universe->UpdateNeutCands();
-	int nBlobs = universe->GetNNeutCands();
-	double recoilEnergy = universe->GetRecoilEnergyGeV();
-	if (whichRecoil==1) recoilEnergy = universe->GetDANRecoilEnergyGeV();
-	if (sample == 0 && !IsTrueSignal(*universe)) continue;
-	else if (sample == 1 && IsTrueSignal(*universe)) continue;
-	//Passes CCQE Cuts that matche Tejin's selection
-	if (PassesCuts(*universe, isPC, region, PCECut)){
-	  
-	  //int nFSPart = universe->GetNFSPart();
-	  int intType = universe->GetInteractionType();
-	  NeutronCandidates::NeutCand leadBlob;
-	  if (nBlobs > 0) leadBlob = universe->GetCurrentLeadingNeutCand();
-	  bool leadBlobPasses = false;
-	  int leadBlobTracker = -1;
-	  int leadBlobPDGBin=0;
-	  double leadBlobLength = -999.0;
-	  double leadBlobE = -999.0;
-	  double leadBlobdEdx = -1.0;
-	  double leadBlobVtxDist = -999.0;
-	  double leadBlobVtxZDist = -999.0;
-
-	  if (nBlobs > 0){
-	    leadBlobPasses = (leadBlob.GetClassifier()==goodBlob);
-	    TVector3 leadFP = leadBlob.GetFlightPath();
-	    if (leadFP.Z() > targetBoundary) leadBlobTracker=1;
-	    else leadBlobTracker=0;
-	    leadBlobPDGBin = PDGbins[leadBlob.GetTopMCPID()];
-	    leadBlobLength = leadBlob.GetDirection().Mag();
-	    leadBlobE = leadBlob.GetTotalE();
-	    if (leadBlobLength > 0.0) leadBlobdEdx=leadBlobE/leadBlobLength;
-	    leadBlobVtxDist = leadFP.Mag();
-	    leadBlobVtxZDist = abs(leadFP.Z());
-	  }
+  LoopOptions opt;
+  opt.isPC=isPC;
+  opt.region=region;
+  opt.sample=sample;
+  opt.whichRecoil=whichRecoil;
+  opt.signalDef=signalDef;
+  opt.PCECut=PCECut;
+
+  SkimReader* skimReader = NULL;
+  SkimWriter* skimWriter = NULL;
+  if (readSkim != ""){
+    skimReader = new SkimReader(readSkim);
+    if (!skimReader->IsOpen()) return 6;
+    cout << "Reading entries from skim " << readSkim << endl;
+  }
+  else if (writeSkim != ""){
+    skimWriter = new SkimWriter(writeSkim);
+    if (!skimWriter->IsOpen()) return 6;
+  }
 
-	  if (intType > 8){
-	    intType=0;
-	  }
-	  else if (intType < 1){
-	    intType=0;
-	  }
-	  else if (intType > 3 && intType < 8){
-	    intType=0;
-	  }
+  //Threads share nothing but the skim they read and the entry queue, so ROOT has to know before any chain or histogram is made
+  if (nThreads > 1){
+    ROOT::EnableThreadSafety();
+    TH1::AddDirectory(false);
+  }
 
-	  //Passes Tejin Recoil and Blob
-	  if (PassesTejinRecoilCut(*universe, isPC, whichRecoil)){
-	    
-	    int TejinBlobValue = PassesTejinBlobCuts(*universe);
-	    //Passes Tejin Recoil and Blob
-	    if (TejinBlobValue){
-	      NeutronCandidates::NeutCands cands = universe->GetCurrentNeutCands();	      
-
-	      for (auto& cand: cands.GetCandidates()){
-		if (cand.second.GetIs3D()==1)++n3DBlobs;
-		if (cand.second.GetClassifier()==goodBlob)++nGoodBlobs;
-
-		int PID = cand.second.GetMCPID();
-		int TopPID = cand.second.GetTopMCPID();
-		int PTrackID = cand.second.GetMCParentTrackID();
-
-		TVector3 FP = cand.second.GetFlightPath();
-		double length = cand.second.GetDirection().Mag();
-		double dEdx = -1.0;
-		double blobE = cand.second.GetTotalE();
-		if (length > 0.0) dEdx = blobE/length;
-		double vtxDist = FP.Mag();
-		double vtxZDist = abs(FP.Z());
-
-		blobESum += blobE;
-		/*
-		if (PTrackID > nFSPart){
-		  //Add something like this to learn how often this happened? ++nMultiIntBlobs;
-		  continue;
-		  }*/
-		double candZ = cand.second.GetBegPos().Z();
-		if (PTrackID==0 && !isPC){
-		  //Additional Requirement of the Chosen Blob being in the tracker only.
-
-		  if (TejinBlobValue==2){
-		    map_hw_ALL_primary_parent_Tejin_TrackerONLY[intType].univHist(universe)->Fill(PDGbins[PID]);
-		    map_hw_ALL_length_Tejin_TrackerONLY[intType].univHist(universe)->Fill(length);
-		    map_hw_ALL_avg_dEdx_Tejin_TrackerONLY[intType].univHist(universe)->Fill(dEdx);
-		    map_hw_ALL_blobE_Tejin_TrackerONLY[intType].univHist(universe)->Fill(blobE);
-		    map_hw_ALL_dist_Tejin_TrackerONLY[intType].univHist(universe)->Fill(vtxDist);
-		    map_hw_ALL_Zdist_Tejin_TrackerONLY[intType].univHist(universe)->Fill(vtxZDist);
-
-		    if (candZ > targetBoundary){
-		      map_hw_tracker_primary_parent_Tejin_TrackerONLY[intType].univHist(universe)->Fill(PDGbins[PID]);
-		      map_hw_tracker_length_Tejin_TrackerONLY[intType].univHist(universe)->Fill(length);
-		      map_hw_tracker_avg_dEdx_Tejin_TrackerONLY[intType].univHist(universe)->Fill(dEdx);
-		      map_hw_tracker_blobE_Tejin_TrackerONLY[intType].univHist(universe)->Fill(blobE);
-		      map_hw_tracker_dist_Tejin_TrackerONLY[intType].univHist(universe)->Fill(vtxDist);
-		      map_hw_tracker_Zdist_Tejin_TrackerONLY[intType].univHist(universe)->Fill(vtxZDist);
-		    }
-
-		    else {
-		      map_hw_target_primary_parent_Tejin_TrackerONLY[intType].univHist(universe)->Fill(PDGbins[PID]);
-		      map_hw_target_length_Tejin_TrackerONLY[intType].univHist(universe)->Fill(length);
-		      map_hw_target_avg_dEdx_Tejin_TrackerONLY[intType].univHist(universe)->Fill(dEdx);
-		      map_hw_target_blobE_Tejin_TrackerONLY[intType].univHist(universe)->Fill(blobE);
-		      map_hw_target_dist_Tejin_TrackerONLY[intType].univHist(universe)->Fill(vtxDist);
-		      map_hw_target_Zdist_Tejin_TrackerONLY[intType].univHist(universe)->Fill(vtxZDist);
-		    }
-		  }
-
-		  map_hw_ALL_primary_parent_Tejin[intType].univHist(universe)->Fill(PDGbins[PID]);
-		  map_hw_ALL_length_Tejin[intType].univHist(universe)->Fill(length);
-		  map_hw_ALL_avg_dEdx_Tejin[intType].univHist(universe)->Fill(dEdx);
-		  map_hw_ALL_blobE_Tejin[intType].univHist(universe)->Fill(blobE);
-		  map_hw_ALL_dist_Tejin[intType].univHist(universe)->Fill(vtxDist);
-		  map_hw_ALL_Zdist_Tejin[intType].univHist(universe)->Fill(vtxZDist);
-		  map_hw_ALL_primary_parent_Recoil[intType].univHist(universe)->Fill(PDGbins[PID]);
-		  map_hw_ALL_length_Recoil[intType].univHist(universe)->Fill(length);
-		  map_hw_ALL_avg_dEdx_Recoil[intType].univHist(universe)->Fill(dEdx);
-		  map_hw_ALL_blobE_Recoil[intType].univHist(universe)->Fill(blobE);
-		  map_hw_ALL_dist_Recoil[intType].univHist(universe)->Fill(vtxDist);
-		  map_hw_ALL_Zdist_Recoil[intType].univHist(universe)->Fill(vtxZDist);
-		  map_hw_ALL_primary_parent_CCQE[intType].univHist(universe)->Fill(PDGbins[PID]);
-		  map_hw_ALL_length_CCQE[intType].univHist(universe)->Fill(length);
-		  map_hw_ALL_avg_dEdx_CCQE[intType].univHist(universe)->Fill(dEdx);
-		  map_hw_ALL_blobE_CCQE[intType].univHist(universe)->Fill(blobE);
-		  map_hw_ALL_dist_CCQE[intType].univHist(universe)->Fill(vtxDist);
-		  map_hw_ALL_Zdist_CCQE[intType].univHist(universe)->Fill(vtxZDist);
-
-		  if (candZ > targetBoundary){
-		    map_hw_tracker_primary_parent_Tejin[intType].univHist(universe)->Fill(PDGbins[PID]);
-		    map_hw_tracker_length_Tejin[intType].univHist(universe)->Fill(length);
-		    map_hw_tracker_avg_dEdx_Tejin[intType].univHist(universe)->Fill(dEdx);
-		    map_hw_tracker_blobE_Tejin[intType].univHist(universe)->Fill(blobE);
-		    map_hw_tracker_dist_Tejin[intType].univHist(universe)->Fill(vtxDist);
-		    map_hw_tracker_Zdist_Tejin[intType].univHist(universe)->Fill(vtxZDist);
-		    map_hw_tracker_primary_parent_Recoil[intType].univHist(universe)->Fill(PDGbins[PID]);
-		    map_hw_tracker_length_Recoil[intType].univHist(universe)->Fill(length);
-		    map_hw_tracker_avg_dEdx_Recoil[intType].univHist(universe)->Fill(dEdx);
-		    map_hw_tracker_blobE_Recoil[intType].univHist(universe)->Fill(blobE);
-		    map_hw_tracker_dist_Recoil[intType].univHist(universe)->Fill(vtxDist);
-		    map_hw_tracker_Zdist_Recoil[intType].univHist(universe)->Fill(vtxZDist);
-		    map_hw_tracker_primary_parent_CCQE[intType].univHist(universe)->Fill(PDGbins[PID]);
-		    map_hw_tracker_length_CCQE[intType].univHist(universe)->Fill(length);
-		    map_hw_tracker_avg_dEdx_CCQE[intType].univHist(universe)->Fill(dEdx);
-		    map_hw_tracker_blobE_CCQE[intType].univHist(universe)->Fill(blobE);
-		    map_hw_tracker_dist_CCQE[intType].univHist(universe)->Fill(vtxDist);
-		    map_hw_tracker_Zdist_CCQE[intType].univHist(universe)->Fill(vtxZDist);
-		  }
-
-		  else{
-		    map_hw_target_primary_parent_Tejin[intType].univHist(universe)->Fill(PDGbins[PID]);
-		    map_hw_target_length_Tejin[intType].univHist(universe)->Fill(length);
-		    map_hw_target_avg_dEdx_Tejin[intType].univHist(universe)->Fill(dEdx);
-		    map_hw_target_blobE_Tejin[intType].univHist(universe)->Fill(blobE);
-		    map_hw_target_dist_Tejin[intType].univHist(universe)->Fill(vtxDist);
-		    map_hw_target_Zdist_Tejin[intType].univHist(universe)->Fill(vtxZDist);
-		    map_hw_target_primary_parent_Recoil[intType].univHist(universe)->Fill(PDGbins[PID]);
-		    map_hw_target_length_Recoil[intType].univHist(universe)->Fill(length);
-		    map_hw_target_avg_dEdx_Recoil[intType].univHist(universe)->Fill(dEdx);
-		    map_hw_target_blobE_Recoil[intType].univHist(universe)->Fill(blobE);
-		    map_hw_target_dist_Recoil[intType].univHist(universe)->Fill(vtxDist);
-		    map_hw_target_Zdist_Recoil[intType].univHist(universe)->Fill(vtxZDist);
-		    map_hw_target_primary_parent_CCQE[intType].univHist(universe)->Fill(PDGbins[PID]);
-		    map_hw_target_length_CCQE[intType].univHist(universe)->Fill(length);
-		    map_hw_target_avg_dEdx_CCQE[intType].univHist(universe)->Fill(dEdx);
-		    map_hw_target_blobE_CCQE[intType].univHist(universe)->Fill(blobE);
-		    map_hw_target_dist_CCQE[intType].univHist(universe)->Fill(vtxDist);
-		    map_hw_target_Zdist_CCQE[intType].univHist(universe)->Fill(vtxZDist);
-		  }
-		}
+  //The MAT reweighters are configured once for the job, before any universe is made
+  if (useWeights){
+    PlotUtils::MinervaUniverse::SetPlaylist(weightPlaylist);
+    PlotUtils::MinervaUniverse::SetAnalysisNuPDG(-14);
+    PlotUtils::MinervaUniverse::SetNuEConstraint(true);
+    PlotUtils::MinervaUniverse::SetNFluxUniverses(nFluxUniverses);
+  }
 
-		else{
-		  //Additional Requirement of the Chosen Blob being in the tracker only.
-		  if (TejinBlobValue==2){
-		    map_hw_ALL_primary_parent_Tejin_TrackerONLY[intType].univHist(universe)->Fill(PDGbins[TopPID]);
-		    map_hw_ALL_length_Tejin_TrackerONLY[intType].univHist(universe)->Fill(length);
-		    map_hw_ALL_avg_dEdx_Tejin_TrackerONLY[intType].univHist(universe)->Fill(dEdx);
-		    map_hw_ALL_blobE_Tejin_TrackerONLY[intType].univHist(universe)->Fill(blobE);
-		    map_hw_ALL_dist_Tejin_TrackerONLY[intType].univHist(universe)->Fill(vtxDist);
-		    map_hw_ALL_Zdist_Tejin_TrackerONLY[intType].univHist(universe)->Fill(vtxZDist);
-
-		    if (candZ > targetBoundary){
-		      map_hw_tracker_primary_parent_Tejin_TrackerONLY[intType].univHist(universe)->Fill(PDGbins[TopPID]);
-		      map_hw_tracker_length_Tejin_TrackerONLY[intType].univHist(universe)->Fill(length);
-		      map_hw_tracker_avg_dEdx_Tejin_TrackerONLY[intType].univHist(universe)->Fill(dEdx);
-		      map_hw_tracker_blobE_Tejin_TrackerONLY[intType].univHist(universe)->Fill(blobE);
-		      map_hw_tracker_dist_Tejin_TrackerONLY[intType].univHist(universe)->Fill(vtxDist);
-		      map_hw_tracker_Zdist_Tejin_TrackerONLY[intType].univHist(universe)->Fill(vtxZDist);
-		    }		  
-
-		    else {
-		      map_hw_target_primary_parent_Tejin_TrackerONLY[intType].univHist(universe)->Fill(PDGbins[TopPID]);
-		      map_hw_target_length_Tejin_TrackerONLY[intType].univHist(universe)->Fill(length);
-		      map_hw_target_avg_dEdx_Tejin_TrackerONLY[intType].univHist(universe)->Fill(dEdx);
-		      map_hw_target_blobE_Tejin_TrackerONLY[intType].univHist(universe)->Fill(blobE);
-		      map_hw_target_dist_Tejin_TrackerONLY[intType].univHist(universe)->Fill(vtxDist);
-		      map_hw_target_Zdist_Tejin_TrackerONLY[intType].univHist(universe)->Fill(vtxZDist);
-		    }
-		  }
-
-		  map_hw_ALL_primary_parent_Tejin[intType].univHist(universe)->Fill(PDGbins[TopPID]);
-		  map_hw_ALL_length_Tejin[intType].univHist(universe)->Fill(length);
-		  map_hw_ALL_avg_dEdx_Tejin[intType].univHist(universe)->Fill(dEdx);
-		  map_hw_ALL_blobE_Tejin[intType].univHist(universe)->Fill(blobE);
-		  map_hw_ALL_dist_Tejin[intType].univHist(universe)->Fill(vtxDist);
-		  map_hw_ALL_Zdist_Tejin[intType].univHist(universe)->Fill(vtxZDist);
-		  map_hw_ALL_primary_parent_Recoil[intType].univHist(universe)->Fill(PDGbins[TopPID]);
-		  map_hw_ALL_length_Recoil[intType].univHist(universe)->Fill(length);
-		  map_hw_ALL_avg_dEdx_Recoil[intType].univHist(universe)->Fill(dEdx);
-		  map_hw_ALL_blobE_Recoil[intType].univHist(universe)->Fill(blobE);
-		  map_hw_ALL_dist_Recoil[intType].univHist(universe)->Fill(vtxDist);
-		  map_hw_ALL_Zdist_Recoil[intType].univHist(universe)->Fill(vtxZDist);
-		  map_hw_ALL_primary_parent_CCQE[intType].univHist(universe)->Fill(PDGbins[TopPID]);
-		  map_hw_ALL_length_CCQE[intType].univHist(universe)->Fill(length);
-		  map_hw_ALL_avg_dEdx_CCQE[intType].univHist(universe)->Fill(dEdx);
-		  map_hw_ALL_blobE_CCQE[intType].univHist(universe)->Fill(blobE);
-		  map_hw_ALL_dist_CCQE[intType].univHist(universe)->Fill(vtxDist);
-		  map_hw_ALL_Zdist_CCQE[intType].univHist(universe)->Fill(vtxZDist);
-
-		  if (candZ > targetBoundary){
-		    map_hw_tracker_primary_parent_Tejin[intType].univHist(universe)->Fill(PDGbins[TopPID]);
-		    map_hw_tracker_length_Tejin[intType].univHist(universe)->Fill(length);
-		    map_hw_tracker_avg_dEdx_Tejin[intType].univHist(universe)->Fill(dEdx);
-		    map_hw_tracker_blobE_Tejin[intType].univHist(universe)->Fill(blobE);
-		    map_hw_tracker_dist_Tejin[intType].univHist(universe)->Fill(vtxDist);
-		    map_hw_tracker_Zdist_Tejin[intType].univHist(universe)->Fill(vtxZDist);
-		    map_hw_tracker_primary_parent_Recoil[intType].univHist(universe)->Fill(PDGbins[TopPID]);
-		    map_hw_tracker_length_Recoil[intType].univHist(universe)->Fill(length);
-		    map_hw_tracker_avg_dEdx_Recoil[intType].univHist(universe)->Fill(dEdx);
-		    map_hw_tracker_blobE_Recoil[intType].univHist(universe)->Fill(blobE);
-		    map_hw_tracker_dist_Recoil[intType].univHist(universe)->Fill(vtxDist);
-		    map_hw_tracker_Zdist_Recoil[intType].univHist(universe)->Fill(vtxZDist);
-		    map_hw_tracker_primary_parent_CCQE[intType].univHist(universe)->Fill(PDGbins[TopPID]);
-		    map_hw_tracker_length_CCQE[intType].univHist(universe)->Fill(length);
-		    map_hw_tracker_avg_dEdx_CCQE[intType].univHist(universe)->Fill(dEdx);
-		    map_hw_tracker_blobE_CCQE[intType].univHist(universe)->Fill(blobE);
-		    map_hw_tracker_dist_CCQE[intType].univHist(universe)->Fill(vtxDist);
-		    map_hw_tracker_Zdist_CCQE[intType].univHist(universe)->Fill(vtxZDist);
-		  }
-
-		  else{
-		    map_hw_target_primary_parent_Tejin[intType].univHist(universe)->Fill(PDGbins[TopPID]);
-		    map_hw_target_length_Tejin[intType].univHist(universe)->Fill(length);
-		    map_hw_target_avg_dEdx_Tejin[intType].univHist(universe)->Fill(dEdx);
-		    map_hw_target_blobE_Tejin[intType].univHist(universe)->Fill(blobE);
-		    map_hw_target_dist_Tejin[intType].univHist(universe)->Fill(vtxDist);
-		    map_hw_target_Zdist_Tejin[intType].univHist(universe)->Fill(vtxZDist);
-		    map_hw_target_primary_parent_Recoil[intType].univHist(universe)->Fill(PDGbins[TopPID]);
-		    map_hw_target_length_Recoil[intType].univHist(universe)->Fill(length);
-		    map_hw_target_avg_dEdx_Recoil[intType].univHist(universe)->Fill(dEdx);
-		    map_hw_target_blobE_Recoil[intType].univHist(universe)->Fill(blobE);
-		    map_hw_target_dist_Recoil[intType].univHist(universe)->Fill(vtxDist);
-		    map_hw_target_Zdist_Recoil[intType].univHist(universe)->Fill(vtxZDist);
-		    map_hw_target_primary_parent_CCQE[intType].univHist(universe)->Fill(PDGbins[TopPID]);
-		    map_hw_target_length_CCQE[intType].univHist(universe)->Fill(length);
-		    map_hw_target_avg_dEdx_CCQE[intType].univHist(universe)->Fill(dEdx);
-		    map_hw_target_blobE_CCQE[intType].univHist(universe)->Fill(blobE);
-		    map_hw_target_dist_CCQE[intType].univHist(universe)->Fill(vtxDist);
-		    map_hw_target_Zdist_CCQE[intType].univHist(universe)->Fill(vtxZDist);
-		  }
-		}
-	      }
+  vector<LoopWorker*> workers;
+  for (int iThread=0; iThread<nThreads; ++iThread) workers.push_back(MakeLoopWorker(playlist, opt, useWeights, skimReader));
+  PlotUtils::ChainWrapper* chain = workers[0]->chain;
+  TChain* tree = chain ? dynamic_cast<TChain*>(chain->GetTree()) : NULL;
+  if (skimReader && !chain) cout << "Not opening " << playlist << ": every entry comes from the skim." << endl;
+
+  if (scanGrid != ""){
+    NeutronCandidates::ClassifierScan* scan = new NeutronCandidates::ClassifierScan();
+    if (!scan->ReadGrid(scanGrid)) return 7;
+    cout << "Scanning " << scan->GetNGridPoints() << " classifier threshold points." << endl;
+    workers[0]->scan = scan;
+    for (int iThread=1; iThread<nThreads; ++iThread) workers[iThread]->scan = new NeutronCandidates::ClassifierScan(*scan);
+  }
 
-	      //Event Level Plots for Passing Tejin Blob Cuts
-	      map_hw_leadBlob_primary_parent_Tejin[intType].univHist(universe)->Fill(leadBlobPDGBin);
-	      map_hw_leadBlob_length_Tejin[intType].univHist(universe)->Fill(leadBlobLength);
-	      map_hw_leadBlob_avg_dEdx_Tejin[intType].univHist(universe)->Fill(leadBlobdEdx);
-	      map_hw_leadBlob_blobE_Tejin[intType].univHist(universe)->Fill(leadBlobE);
-	      map_hw_leadBlob_dist_Tejin[intType].univHist(universe)->Fill(leadBlobVtxDist);
-	      map_hw_leadBlob_Zdist_Tejin[intType].univHist(universe)->Fill(leadBlobVtxZDist);
-	      map_hw_leadBlob_location_Tejin[intType].univHist(universe)->Fill(leadBlobTracker);
-	      if (leadBlobPasses) map_hw_leadBlob_passes_classifier_Tejin[intType].univHist(universe)->Fill(1);
-	      else map_hw_leadBlob_passes_classifier_Tejin[intType].univHist(universe)->Fill(0);
-	      map_hw_n3DBlobs_Tejin[intType].univHist(universe)->Fill(n3DBlobs);
-	      map_hw_nGoodBlobs_Tejin[intType].univHist(universe)->Fill(nGoodBlobs);
-	      map_hw_nBlobs_Tejin[intType].univHist(universe)->Fill(nBlobs);
-	      map_hw_AvgBlobEnergy_Tejin[intType].univHist(universe)->Fill(blobESum/((double)(nBlobs)));
-	      map_hw_RecoilEnergyGeV_Tejin[intType].univHist(universe)->Fill(recoilEnergy);
-
-	      if (TejinBlobValue==2){
-		map_hw_leadBlob_primary_parent_Tejin_TrackerONLY[intType].univHist(universe)->Fill(leadBlobPDGBin);
-		map_hw_leadBlob_length_Tejin_TrackerONLY[intType].univHist(universe)->Fill(leadBlobLength);
-		map_hw_leadBlob_avg_dEdx_Tejin_TrackerONLY[intType].univHist(universe)->Fill(leadBlobdEdx);
-		map_hw_leadBlob_blobE_Tejin_TrackerONLY[intType].univHist(universe)->Fill(leadBlobE);
-		map_hw_leadBlob_dist_Tejin_TrackerONLY[intType].univHist(universe)->Fill(leadBlobVtxDist);
-		map_hw_leadBlob_Zdist_Tejin_TrackerONLY[intType].univHist(universe)->Fill(leadBlobVtxZDist);
-		map_hw_leadBlob_location_Tejin_TrackerONLY[intType].univHist(universe)->Fill(leadBlobTracker);
-		if (leadBlobPasses) map_hw_leadBlob_passes_classifier_Tejin_TrackerONLY[intType].univHist(universe)->Fill(1);
-		else map_hw_leadBlob_passes_classifier_Tejin_TrackerONLY[intType].univHist(universe)->Fill(0);
-		map_hw_n3DBlobs_Tejin_TrackerONLY[intType].univHist(universe)->Fill(n3DBlobs);
-		map_hw_nGoodBlobs_Tejin_TrackerONLY[intType].univHist(universe)->Fill(nGoodBlobs);
-		map_hw_nBlobs_Tejin_TrackerONLY[intType].univHist(universe)->Fill(nBlobs);
-		map_hw_AvgBlobEnergy_Tejin_TrackerONLY[intType].univHist(universe)->Fill(blobESum/((double)(nBlobs)));
-		map_hw_RecoilEnergyGeV_Tejin_TrackerONLY[intType].univHist(universe)->Fill(recoilEnergy);
-	      }
-	    }
-	  
-	    //Passes Tejin Recoil Not Blob
-	    else {
-	      NeutronCandidates::NeutCands cands = universe->GetCurrentNeutCands();
-	      for (auto& cand: cands.GetCandidates()){
-		if (cand.second.GetIs3D()==1)++n3DBlobs;
-		if (cand.second.GetClassifier()==goodBlob)++nGoodBlobs;
-
-		//cout << "GOOD" << endl;	      
-		int PID = cand.second.GetMCPID();
-		int TopPID = cand.second.GetTopMCPID();
-		int PTrackID = cand.second.GetMCParentTrackID();
-
-		TVector3 FP = cand.second.GetFlightPath();
-		double length = cand.second.GetDirection().Mag();
-		double blobE = cand.second.GetTotalE();
-		double dEdx = -1.0;
-		if (length > 0.0) dEdx = blobE/length;
-		double vtxDist = FP.Mag();
-		double vtxZDist = abs(FP.Z());
-
-		blobESum += blobE;
-		/*
-		if (PTrackID > nFSPart){
-		  //Add something like this to learn how often this happened? ++nMultiIntBlobs;
-		  continue;
-		  }*/
-		double candZ = cand.second.GetBegPos().Z();
-		//if (cand.second.GetIs3D()==1) cout << "BlobIs3D" << endl;
-
-		if (PTrackID==0 && !isPC){
-		  map_hw_ALL_primary_parent_Recoil[intType].univHist(universe)->Fill(PDGbins[PID]);
-		  map_hw_ALL_length_Recoil[intType].univHist(universe)->Fill(length);
-		  map_hw_ALL_avg_dEdx_Recoil[intType].univHist(universe)->Fill(dEdx);
-		  map_hw_ALL_blobE_Recoil[intType].univHist(universe)->Fill(blobE);
-		  map_hw_ALL_dist_Recoil[intType].univHist(universe)->Fill(vtxDist);
-		  map_hw_ALL_Zdist_Recoil[intType].univHist(universe)->Fill(vtxZDist);
-		  map_hw_ALL_primary_parent_CCQE[intType].univHist(universe)->Fill(PDGbins[PID]);
-		  map_hw_ALL_length_CCQE[intType].univHist(universe)->Fill(length);
-		  map_hw_ALL_avg_dEdx_CCQE[intType].univHist(universe)->Fill(dEdx);
-		  map_hw_ALL_blobE_CCQE[intType].univHist(universe)->Fill(blobE);
-		  map_hw_ALL_dist_CCQE[intType].univHist(universe)->Fill(vtxDist);
-		  map_hw_ALL_Zdist_CCQE[intType].univHist(universe)->Fill(vtxZDist);
-
-		  if (candZ > targetBoundary){
-		    map_hw_tracker_primary_parent_Recoil[intType].univHist(universe)->Fill(PDGbins[PID]);
-		    map_hw_tracker_length_Recoil[intType].univHist(universe)->Fill(length);
-		    map_hw_tracker_avg_dEdx_Recoil[intType].univHist(universe)->Fill(dEdx);
-		    map_hw_tracker_blobE_Recoil[intType].univHist(universe)->Fill(blobE);
-		    map_hw_tracker_dist_Recoil[intType].univHist(universe)->Fill(vtxDist);
-		    map_hw_tracker_Zdist_Recoil[intType].univHist(universe)->Fill(vtxZDist);
-		    map_hw_tracker_primary_parent_CCQE[intType].univHist(universe)->Fill(PDGbins[PID]);
-		    map_hw_tracker_length_CCQE[intType].univHist(universe)->Fill(length);
-		    map_hw_tracker_avg_dEdx_CCQE[intType].univHist(universe)->Fill(dEdx);
-		    map_hw_tracker_blobE_CCQE[intType].univHist(universe)->Fill(blobE);
-		    map_hw_tracker_dist_CCQE[intType].univHist(universe)->Fill(vtxDist);
-		    map_hw_tracker_Zdist_CCQE[intType].univHist(universe)->Fill(vtxZDist);
-		  }
-
-		  else{
-		    map_hw_target_primary_parent_Recoil[intType].univHist(universe)->Fill(PDGbins[PID]);
-		    map_hw_target_length_Recoil[intType].univHist(universe)->Fill(length);
-		    map_hw_target_avg_dEdx_Recoil[intType].univHist(universe)->Fill(dEdx);
-		    map_hw_target_blobE_Recoil[intType].univHist(universe)->Fill(blobE);
-		    map_hw_target_dist_Recoil[intType].univHist(universe)->Fill(vtxDist);
-		    map_hw_target_Zdist_Recoil[intType].univHist(universe)->Fill(vtxZDist);
-		    map_hw_target_primary_parent_CCQE[intType].univHist(universe)->Fill(PDGbins[PID]);
-		    map_hw_target_length_CCQE[intType].univHist(universe)->Fill(length);
-		    map_hw_target_avg_dEdx_CCQE[intType].univHist(universe)->Fill(dEdx);
-		    map_hw_target_blobE_CCQE[intType].univHist(universe)->Fill(blobE);
-		    map_hw_target_dist_CCQE[intType].univHist(universe)->Fill(vtxDist);
-		    map_hw_target_Zdist_CCQE[intType].univHist(universe)->Fill(vtxZDist);
-		  }
-		}
+  if (recordBranches != "" && chain){
+    for (auto worker : workers) worker->recorder = new BranchWhitelist::Recorder(dynamic_cast<TChain*>(worker->chain->GetTree()));
+  }
 
-		else{
-		  map_hw_ALL_primary_parent_Recoil[intType].univHist(universe)->Fill(PDGbins[TopPID]);
-		  map_hw_ALL_length_Recoil[intType].univHist(universe)->Fill(length);
-		  map_hw_ALL_avg_dEdx_Recoil[intType].univHist(universe)->Fill(dEdx);
-		  map_hw_ALL_blobE_Recoil[intType].univHist(universe)->Fill(blobE);
-		  map_hw_ALL_dist_Recoil[intType].univHist(universe)->Fill(vtxDist);
-		  map_hw_ALL_Zdist_Recoil[intType].univHist(universe)->Fill(vtxZDist);
-		  map_hw_ALL_primary_parent_CCQE[intType].univHist(universe)->Fill(PDGbins[TopPID]);
-		  map_hw_ALL_length_CCQE[intType].univHist(universe)->Fill(length);
-		  map_hw_ALL_avg_dEdx_CCQE[intType].univHist(universe)->Fill(dEdx);
-		  map_hw_ALL_blobE_CCQE[intType].univHist(universe)->Fill(blobE);
-		  map_hw_ALL_dist_CCQE[intType].univHist(universe)->Fill(vtxDist);
-		  map_hw_ALL_Zdist_CCQE[intType].univHist(universe)->Fill(vtxZDist);
-
-		  if (candZ > targetBoundary){
-		    map_hw_tracker_primary_parent_Recoil[intType].univHist(universe)->Fill(PDGbins[TopPID]);
-		    map_hw_tracker_length_Recoil[intType].univHist(universe)->Fill(length);
-		    map_hw_tracker_avg_dEdx_Recoil[intType].univHist(universe)->Fill(dEdx);
-		    map_hw_tracker_blobE_Recoil[intType].univHist(universe)->Fill(blobE);
-		    map_hw_tracker_dist_Recoil[intType].univHist(universe)->Fill(vtxDist);
-		    map_hw_tracker_Zdist_Recoil[intType].univHist(universe)->Fill(vtxZDist);
-		    map_hw_tracker_primary_parent_CCQE[intType].univHist(universe)->Fill(PDGbins[TopPID]);
-		    map_hw_tracker_length_CCQE[intType].univHist(universe)->Fill(length);
-		    map_hw_tracker_avg_dEdx_CCQE[intType].univHist(universe)->Fill(dEdx);
-		    map_hw_tracker_blobE_CCQE[intType].univHist(universe)->Fill(blobE);
-		    map_hw_tracker_dist_CCQE[intType].univHist(universe)->Fill(vtxDist);
-		    map_hw_tracker_Zdist_CCQE[intType].univHist(universe)->Fill(vtxZDist);
-		  }
-
-		  else{
-		    map_hw_target_primary_parent_Recoil[intType].univHist(universe)->Fill(PDGbins[TopPID]);
-		    map_hw_target_length_Recoil[intType].univHist(universe)->Fill(length);
-		    map_hw_target_avg_dEdx_Recoil[intType].univHist(universe)->Fill(dEdx);
-		    map_hw_target_blobE_Recoil[intType].univHist(universe)->Fill(blobE);
-		    map_hw_target_dist_Recoil[intType].univHist(universe)->Fill(vtxDist);
-		    map_hw_target_Zdist_Recoil[intType].univHist(universe)->Fill(vtxZDist);
-		    map_hw_target_primary_parent_CCQE[intType].univHist(universe)->Fill(PDGbins[TopPID]);
-		    map_hw_target_length_CCQE[intType].univHist(universe)->Fill(length);
-		    map_hw_target_avg_dEdx_CCQE[intType].univHist(universe)->Fill(dEdx);
-		    map_hw_target_blobE_CCQE[intType].univHist(universe)->Fill(blobE);
-		    map_hw_target_dist_CCQE[intType].univHist(universe)->Fill(vtxDist);
-		    map_hw_target_Zdist_CCQE[intType].univHist(universe)->Fill(vtxZDist);
-		  }
-		}
-	      }
-	    }
-
-	    //Event level Plots for passing Tejin Recoil but not Blob
-	    map_hw_leadBlob_primary_parent_Recoil[intType].univHist(universe)->Fill(leadBlobPDGBin);
-	    map_hw_leadBlob_length_Recoil[intType].univHist(universe)->Fill(leadBlobLength);
-	    map_hw_leadBlob_avg_dEdx_Recoil[intType].univHist(universe)->Fill(leadBlobdEdx);
-	    map_hw_leadBlob_blobE_Recoil[intType].univHist(universe)->Fill(leadBlobE);
-	    map_hw_leadBlob_dist_Recoil[intType].univHist(universe)->Fill(leadBlobVtxDist);
-	    map_hw_leadBlob_Zdist_Recoil[intType].univHist(universe)->Fill(leadBlobVtxZDist);
-	    map_hw_leadBlob_location_Recoil[intType].univHist(universe)->Fill(leadBlobTracker);
-	    if (leadBlobPasses) map_hw_leadBlob_passes_classifier_Recoil[intType].univHist(universe)->Fill(1);
-	    else map_hw_leadBlob_passes_classifier_Recoil[intType].univHist(universe)->Fill(0);	  
-	    map_hw_n3DBlobs_Recoil[intType].univHist(universe)->Fill(n3DBlobs);
-	    map_hw_nGoodBlobs_Recoil[intType].univHist(universe)->Fill(nGoodBlobs);
-	    map_hw_nBlobs_Recoil[intType].univHist(universe)->Fill(nBlobs);
-	    map_hw_AvgBlobEnergy_Recoil[intType].univHist(universe)->Fill(blobESum/((double)(nBlobs)));
-	    map_hw_RecoilEnergyGeV_Recoil[intType].univHist(universe)->Fill(recoilEnergy);
-	  }
-	  //Fails Tejin Recoil. I'm not going to treat the Tejin Blob Cut as special/independent of this recoil cut.
-	  else {
-	    NeutronCandidates::NeutCands cands = universe->GetCurrentNeutCands();
-	    for (auto& cand: cands.GetCandidates()){
-	      if (cand.second.GetIs3D()==1)++n3DBlobs;
-	      if (cand.second.GetClassifier()==goodBlob)++nGoodBlobs;
-
-	      //cout << "GOOD" << endl;	      
-	      int PID = cand.second.GetMCPID();
-	      int TopPID = cand.second.GetTopMCPID();
-	      int PTrackID = cand.second.GetMCParentTrackID();
-
-	      TVector3 FP = cand.second.GetFlightPath();
-	      double length = cand.second.GetDirection().Mag();
-	      double blobE = cand.second.GetTotalE();
-	      double dEdx = -1.0;
-	      if (length > 0.0) dEdx = blobE/length;
-	      double vtxDist = FP.Mag();
-	      double vtxZDist = abs(FP.Z());
-
-	      blobESum += blobE;
-	      /*
-	      if (PTrackID > nFSPart){
-		//Add something like this to learn how often this happened? ++nMultiIntBlobs;
-		continue;
-		}*/
-	      double candZ = cand.second.GetBegPos().Z();
-	      //if (cand.second.GetIs3D()==1) cout << "BlobIs3D" << endl;
-
-	      if (PTrackID==0 && !isPC){
-		map_hw_ALL_primary_parent_CCQE[intType].univHist(universe)->Fill(PDGbins[PID]);
-		map_hw_ALL_length_CCQE[intType].univHist(universe)->Fill(length);
-		map_hw_ALL_avg_dEdx_CCQE[intType].univHist(universe)->Fill(dEdx);
-		map_hw_ALL_blobE_CCQE[intType].univHist(universe)->Fill(blobE);
-		map_hw_ALL_dist_CCQE[intType].univHist(universe)->Fill(vtxDist);
-		map_hw_ALL_Zdist_CCQE[intType].univHist(universe)->Fill(vtxZDist);
-
-		if (candZ > targetBoundary){
-		  map_hw_tracker_primary_parent_CCQE[intType].univHist(universe)->Fill(PDGbins[PID]);
-		  map_hw_tracker_length_CCQE[intType].univHist(universe)->Fill(length);
-		  map_hw_tracker_avg_dEdx_CCQE[intType].univHist(universe)->Fill(dEdx);
-		  map_hw_tracker_blobE_CCQE[intType].univHist(universe)->Fill(blobE);
-		  map_hw_tracker_dist_CCQE[intType].univHist(universe)->Fill(vtxDist);
-		  map_hw_tracker_Zdist_CCQE[intType].univHist(universe)->Fill(vtxZDist);
-		}
+  if (branchWhitelist != ""){
+    vector<string> branches = BranchWhitelist::Read(branchWhitelist);
+    if (branches.empty()) return 8;
+    if (chain){
+      for (auto worker : workers) BranchWhitelist::Apply(worker->chain->GetTree(), branches);
+      cout << "Reading only the " << branches.size() << " branches in " << branchWhitelist << endl;
+    }
+    else cout << "No chain is read, so " << branchWhitelist << " is ignored." << endl;
+  }
 
-		else{ 
-		  map_hw_target_primary_parent_CCQE[intType].univHist(universe)->Fill(PDGbins[PID]);
-		  map_hw_target_length_CCQE[intType].univHist(universe)->Fill(length);
-		  map_hw_target_avg_dEdx_CCQE[intType].univHist(universe)->Fill(dEdx);
-		  map_hw_target_blobE_CCQE[intType].univHist(universe)->Fill(blobE);
-		  map_hw_target_dist_CCQE[intType].univHist(universe)->Fill(vtxDist);
-		  map_hw_target_Zdist_CCQE[intType].univHist(universe)->Fill(vtxZDist);
+  //Entries [firstEntry, lastEntry). Without --last-entry the end is nEntries as before, or everything.
+  Long64_t nAvailable = skimReader ? skimReader->GetNEvents() : chain->GetEntries();
+  if (lastEntry < 0) lastEntry = (nEntries > 0) ? nEntries : nAvailable;
+  if (lastEntry > nAvailable) lastEntry = nAvailable;
+  if (nShards > 0){
+    EntryRange shard = EntryQueue::GetShard(tree, firstEntry, lastEntry, shardIndex, nShards);
+    firstEntry = shard.first;
+    lastEntry = shard.last;
+  }
+  if (firstEntry > lastEntry) firstEntry = lastEntry;
+  nEntries = lastEntry-firstEntry;
+  //Nothing before firstEntry is read; the cache only prefetches baskets inside the range
+  for (auto worker : workers){
+    if (worker->chain) worker->chain->GetTree()->SetCacheEntryRange(firstEntry, lastEntry);
+  }
+  string rangeName = "";
+  if (nShards > 0) rangeName = "_shard"+to_string(shardIndex)+"of"+to_string(nShards);
+  else if (hasRange) rangeName = "_entries"+to_string(firstEntry)+"to"+to_string(lastEntry);
+  cout << "Processing " << nEntries << " events, entries " << firstEntry << " to " << lastEntry << "." << endl;
+  #ifdef COUNT_ALLOCS
+  unsigned long long nAllocsStart = AllocCounter::GetNAllocs();
+  #endif
+  //A missing or switched-off branch throws from its BranchHandle. Stop there rather than fill histograms from a half-read entry.
+  try{
+    if (nThreads == 1){
+      for (Long64_t i=firstEntry; i<lastEntry;++i){
+	if (nEntries >= 100 && (i-firstEntry)%(nEntries/100)==0) cout << (100*(i-firstEntry))/nEntries << "% finished." << endl;
+	//if (i%(10000)==0) cout << i << " entries finished." << endl;
+	ProcessEntry(*workers[0], i, opt, skimWriter);
+      }
+    }
+    else{
+      //Thread 0 runs the selection warm-up alone and every thread then uses the order it found, so the cut-flow tables can be added
+      Long64_t warmEnd = firstEntry;
+      while (warmEnd < lastEntry && !workers[0]->selection->IsOrdered()) ProcessEntry(*workers[0], warmEnd++, opt, NULL);
+      workers[0]->selection->Finish();
+      for (int iThread=1; iThread<nThreads; ++iThread) workers[iThread]->selection->SetOrder(workers[0]->selection->GetOrder());
+      EntryQueue queue(EntryQueue::GetClusterRanges(tree, warmEnd, lastEntry), nThreads);
+      atomic<Long64_t> nDone(warmEnd-firstEntry);
+      //An exception cannot leave a thread, so the first one is kept here and every thread stops at its next entry
+      atomic<bool> failed(false);
+      string failure;
+      mutex coutLock;
+      vector<thread> threads;
+      for (int iThread=0; iThread<nThreads; ++iThread){
+	threads.push_back(thread([&, iThread]{
+	      try{
+		EntryRange range;
+		while (!failed && queue.Next(iThread, range)){
+		  for (Long64_t i=range.first; i<range.last && !failed; ++i) ProcessEntry(*workers[iThread], i, opt, NULL);
+		  Long64_t done = (nDone += range.last-range.first);
+		  lock_guard<mutex> lock(coutLock);
+		  cout << (100*done)/nEntries << "% finished." << endl;
 		}
 	      }
+	      catch (const std::exception& e){
+		lock_guard<mutex> lock(coutLock);
+		if (!failed) failure = "Thread "+to_string(iThread)+": "+e.what();
+		failed = true;
+	      }
+	    }));
+      }
+      for (auto& workerThread : threads) workerThread.join();
+      if (failed) throw std::runtime_error(failure);
+      //Always added in thread order, so the sums do not depend on which thread finished first
+      for (int iThread=1; iThread<nThreads; ++iThread){
+	AddHists(*workers[0]->hists, workers[0]->error_bands, *workers[iThread]->hists, workers[iThread]->error_bands);
+	if (workers[0]->scan) workers[0]->scan->Add(*workers[iThread]->scan);
+      }
+    }
+  }
+  catch (const std::exception& e){
+    cout << "Stopped reading entries: " << e.what() << endl;
+    return 8;
+  }
+  NeutronCandidates::ClassifierScan* scan = workers[0]->scan;
 
-	      else{
-		map_hw_ALL_primary_parent_CCQE[intType].univHist(universe)->Fill(PDGbins[TopPID]);
-		map_hw_ALL_length_CCQE[intType].univHist(universe)->Fill(length);
-		map_hw_ALL_avg_dEdx_CCQE[intType].univHist(universe)->Fill(dEdx);
-		map_hw_ALL_blobE_CCQE[intType].univHist(universe)->Fill(blobE);
-		map_hw_ALL_dist_CCQE[intType].univHist(universe)->Fill(vtxDist);
-		map_hw_ALL_Zdist_CCQE[intType].univHist(universe)->Fill(vtxZDist);
-
-		if (candZ > targetBoundary){
-		  map_hw_tracker_primary_parent_CCQE[intType].univHist(universe)->Fill(PDGbins[TopPID]);
-		  map_hw_tracker_length_CCQE[intType].univHist(universe)->Fill(length);
-		  map_hw_tracker_avg_dEdx_CCQE[intType].univHist(universe)->Fill(dEdx);
-		  map_hw_tracker_blobE_CCQE[intType].univHist(universe)->Fill(blobE);
-		  map_hw_tracker_dist_CCQE[intType].univHist(universe)->Fill(vtxDist);
-		  map_hw_tracker_Zdist_CCQE[intType].univHist(universe)->Fill(vtxZDist);
-		}
+  //All threads ran in thread 0's order (see above), so their tables add up
+  workers[0]->selection->Finish();
+  for (int iThread=1; iThread<nThreads; ++iThread){
+    if (!workers[0]->selection->Add(*workers[iThread]->selection)) cout << "Thread " << iThread << " ran its cuts in another order, so its cut flow is left out." << endl;
+  }
+  cout << "Cut flow:" << endl;
+  workers[0]->selection->Print(cout);
 
-		else{
-		  map_hw_target_primary_parent_CCQE[intType].univHist(universe)->Fill(PDGbins[TopPID]);
-		  map_hw_target_length_CCQE[intType].univHist(universe)->Fill(length);
-		  map_hw_target_avg_dEdx_CCQE[intType].univHist(universe)->Fill(dEdx);
-		  map_hw_target_blobE_CCQE[intType].univHist(universe)->Fill(blobE);
-		  map_hw_target_dist_CCQE[intType].univHist(universe)->Fill(vtxDist);
-		  map_hw_target_Zdist_CCQE[intType].univHist(universe)->Fill(vtxZDist);
-		}
-	      }
-	    }
-	  }
+  if (skimWriter){
+    skimWriter->Close();
+    cout << "Wrote skim " << writeSkim << endl;
+  }
 
-	  //Event Level Plots for passing Only the CCQE level no Recoil
-	  map_hw_leadBlob_primary_parent_CCQE[intType].univHist(universe)->Fill(leadBlobPDGBin);
-	  map_hw_leadBlob_length_CCQE[intType].univHist(universe)->Fill(leadBlobLength);
-	  map_hw_leadBlob_avg_dEdx_CCQE[intType].univHist(universe)->Fill(leadBlobdEdx);
-	  map_hw_leadBlob_blobE_CCQE[intType].univHist(universe)->Fill(leadBlobE);
-	  map_hw_leadBlob_dist_CCQE[intType].univHist(universe)->Fill(leadBlobVtxDist);
-	  map_hw_leadBlob_Zdist_CCQE[intType].univHist(universe)->Fill(leadBlobVtxZDist);
-	  map_hw_leadBlob_location_CCQE[intType].univHist(universe)->Fill(leadBlobTracker);
-	  if (leadBlobPasses) map_hw_leadBlob_passes_classifier_CCQE[intType].univHist(universe)->Fill(1);
-	  else map_hw_leadBlob_passes_classifier_CCQE[intType].univHist(universe)->Fill(0);	  
-	  map_hw_n3DBlobs_CCQE[intType].univHist(universe)->Fill(n3DBlobs);
-	  map_hw_nGoodBlobs_CCQE[intType].univHist(universe)->Fill(nGoodBlobs);
-	  map_hw_nBlobs_CCQE[intType].univHist(universe)->Fill(nBlobs);
-	  map_hw_AvgBlobEnergy_CCQE[intType].univHist(universe)->Fill(blobESum/((double)(nBlobs)));
-	  map_hw_RecoilEnergyGeV_CCQE[intType].univHist(universe)->Fill(recoilEnergy);
-	}
+  if (recordBranches != ""){
+    //Branches read through the ChainWrapper or PlotUtils show up in the chain, file by file; the universes' own handles are added as well
+    vector<string> branches;
+    for (auto worker : workers){
+      if (worker->recorder){
+	vector<string> read = worker->recorder->GetReadBranches();
+	branches.insert(branches.end(), read.begin(), read.end());
+      }
+      for (auto band : worker->error_bands){
+	for (auto universe : band.second) universe->AddUsedBranches(branches);
       }
     }
+    sort(branches.begin(), branches.end());
+    branches.erase(unique(branches.begin(), branches.end()), branches.end());
+    if (BranchWhitelist::Write(recordBranches, branches)) cout << "Recorded " << branches.size() << " branches to " << recordBranches << endl;
   }
 
-  TFile* outFile = new TFile((TString)(outDir)+"runEventLoop_sample_"+sampleNames[sample]+"_region_"+regionNames[region]+"_"+TString(playlistStub)+"_"+TString(tag)+"_"+TString(to_string(nEntries))+"_Events.root","RECREATE");
-  cout << "Writing" << endl;
-  for (auto band : error_bands){
-    int i=0;
-    vector<CVUniverse*> error_band_universes = band.second;
-    for (auto universe : error_band_universes){
-      Write1DHistsToFile(histsALL, universe, outFile);
-    }
+  unsigned long long memoHits=0, memoMisses=0, sharedHits=0, sharedMisses=0;
+  for (auto worker : workers){
+    memoHits += worker->CV->GetMemoHits();
+    memoMisses += worker->CV->GetMemoMisses();
+    sharedHits += worker->sharedEntry.GetHits();
+    sharedMisses += worker->sharedEntry.GetMisses();
   }
+  cout << "CV memo cache hits: " << memoHits << " misses: " << memoMisses << endl;
+  cout << "Shared entry store hits: " << sharedHits << " misses: " << sharedMisses << endl;
+
+  #ifdef COUNT_ALLOCS
+  cout << "Heap allocations per entry: " << (double)(AllocCounter::GetNAllocs()-nAllocsStart)/(double)nEntries << endl;
+  CVUniverse* CV = workers[0]->CV;
+  cout << "Largest per-entry arena use for CV [bytes]: " << CV->GetArena().GetMaxBytesUsed() << endl;
+  #endif
+
+  TFile* outFile = new TFile((TString)(outDir)+"runEventLoop_sample_"+sampleNames[sample]+"_region_"+regionNames[region]+"_"+TString(playlistStub)+"_"+TString(tag)+TString(rangeName)+"_"+TString(to_string(nEntries))+"_Events.root","RECREATE");
+  cout << "Writing" << endl;
+  Write1DHistsToFile(workers[0]->hists->histsALL, outFile);
 
   outFile->Close();
+
+  string cutFlowName = outDir+"runEventLoop_sample_"+string(sampleNames[sample].Data())+"_region_"+string(regionNames[region].Data())+"_"+playlistStub+"_"+tag+rangeName+"_"+to_string(nEntries)+"_Events_CutFlow.txt";
+  ofstream cutFlowOut(cutFlowName.c_str());
+  workers[0]->selection->Print(cutFlowOut);
+  cout << "Wrote cut flow " << cutFlowName << endl;
+
+  if (scan){
+    string scanName = outDir+"runEventLoop_sample_"+string(sampleNames[sample].Data())+"_region_"+string(regionNames[region].Data())+"_"+playlistStub+"_"+tag+rangeName+"_"+to_string(nEntries)+"_Events_ClassifierScan.txt";
+    ofstream scanOut(scanName.c_str());
+    scan->Write(scanOut);
+    cout << "Wrote classifier scan " << scanName << endl;
+  }
+
   cout << "HEY YOU DID IT!!!" << endl;
   return 0;
 
@@ -54,7 +54,7 @@ using namespace std;
 double targetBoundary = 5850.0;
 
 bool PassesFVCuts(CVUniverse& univ, int region){
-  vector<double> vtx = univ.GetVtx();
+  ArenaSpan<double> vtx = univ.GetVtx();
   double side = 850.0*2.0/sqrt(3.0);
   if (region == 0){
     if (vtx[2] < targetBoundary || vtx[2] > 8422.0 ) return false;
@@ -84,8 +84,8 @@ bool PassesCleanCCAntiNuCuts(CVUniverse& univ, int isPC){
     (univ.GetNDeadDiscriminatorsUpstreamMuon() < 2) &&
     (univ.GetNuHelicity() == 2) &&
     (MINOSMatch == 1) &&
-    (TMath::RadToDeg()*univ.GetThetamu() < 20.0) &&
-    (univ.GetPmu() < 20000.0 && univ.GetPmu() > 1500.0);
+    (TMath::RadToDeg()*univ.GetThetamuMemo() < 20.0) &&
+    (univ.GetPmuMemo() < 20000.0 && univ.GetPmuMemo() > 1500.0);
 }
 
 //Should Code the more general anti-nu CCQE cuts at some point... but this is a focus for Tejin stuff...
@@ -102,11 +102,11 @@ bool PassesTejinRecoilCut(CVUniverse& univ, int isPC){
 bool PassesTejinCCQECuts(CVUniverse& univ){
   //bool PassesRecoilECut = false;
   //recoil energy cut and Q2 calculation are unclear to me. Need investigate...
-  vector<double> EMBlobInfo = univ.GetEMNBlobsTotalEnergyTotalNHits();
+  EMBlobSummary EMBlobInfo = univ.GetEMNBlobsTotalEnergyTotalNHits();
   return 
     (univ.GetNTracks() == 1) &&
-    (EMBlobInfo.at(0) < 2) &&
-    (EMBlobInfo.at(1) >= 10.0*EMBlobInfo.at(2)) &&
+    (EMBlobInfo.nBlobs < 2) &&
+    (EMBlobInfo.totalE >= 10.0*EMBlobInfo.nHits) &&
     (univ.GetNImprovedMichel() > 0);
 }
 
@@ -116,7 +116,8 @@ int PassesTejinBlobCuts(CVUniverse& univ){
   double leadingEGeV = 0.001*leadingBlob.GetTotalE();
   TVector3 leadingPos=leadingBlob.GetBegPos();
   TVector3 leadingFP=leadingBlob.GetFlightPath();
-  TVector3 muonMom(univ.GetMuon4V().Z(),univ.GetMuon4V().Y(),univ.GetMuon4V().Z());
+  TLorentzVector muon4V = univ.GetMuon4VMemo();
+  TVector3 muonMom(muon4V.Z(),muon4V.Y(),muon4V.Z());
   double Q2GeV = univ.GetQ2QEPickledGeV();
   double MnGeV = 0.939566; //Should check what others might use, but this will be close enough for now...
   if (leadingFP.Mag()==0 || muonMom.Mag()==0) return 0;
@@ -247,20 +248,20 @@ int main(int argc, char* argv[]) {
 	cout << "" << endl;
 	universe->SetEntry(i);
 	universe->UpdateNeutCands();
-	for (auto& cand: universe->GetCurrentNeutCands().GetCandidates()){
-	  cout << "ID: " << cand.second.GetID() << endl;
-	  cout << "Z Dist: " << cand.second.GetFlightPath().Z() << endl;
-	  cout << "TotalE: " << cand.second.GetTotalE() << endl;
-	  cout << "Angle: " << cand.second.GetAngleToFP() << endl;
-	  cout << "Is3D: " << cand.second.GetIs3D() << endl;
-	  cout << "Classifier: " << cand.second.GetClassifier() << endl;
-	  cout << "Direction Magnitude: " << cand.second.GetDirection().Mag() << endl;
-	  cout << "Beg X: " << cand.second.GetBegPos().X() << endl;
-	  cout << "End X: " << cand.second.GetEndPos().X() << endl;
-	  cout << "Beg Y: " << cand.second.GetBegPos().Y() << endl;
-	  cout << "End Y: " << cand.second.GetEndPos().Y() << endl;
-	  cout << "Beg Z: " << cand.second.GetBegPos().Z() << endl;
-	  cout << "End Z: " << cand.second.GetEndPos().Z() << endl;
+	for (const auto& cand: universe->GetCurrentNeutCands()){
+	  cout << "ID: " << cand.GetID() << endl;
+	  cout << "Z Dist: " << cand.GetFlightPath().Z() << endl;
+	  cout << "TotalE: " << cand.GetTotalE() << endl;
+	  cout << "Angle: " << cand.GetAngleToFP() << endl;
+	  cout << "Is3D: " << cand.GetIs3D() << endl;
+	  cout << "Classifier: " << cand.GetClassifier() << endl;
+	  cout << "Direction Magnitude: " << cand.GetDirection().Mag() << endl;
+	  cout << "Beg X: " << cand.GetBegPos().X() << endl;
+	  cout << "End X: " << cand.GetEndPos().X() << endl;
+	  cout << "Beg Y: " << cand.GetBegPos().Y() << endl;
+	  cout << "End Y: " << cand.GetEndPos().Y() << endl;
+	  cout << "Beg Z: " << cand.GetBegPos().Z() << endl;
+	  cout << "End Z: " << cand.GetEndPos().Z() << endl;
 	  cout << "" << endl;
 	}
       }
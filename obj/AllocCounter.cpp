@@ -0,0 +1,46 @@
+//File: AllocCounter.cpp
+//Info: Replacement global operator new/delete that count allocations. The replacements are only compiled with -DCOUNT_ALLOCS=ON.
+//
+//Author: David Last dlast@sas.upenn.edu/lastd44@gmail.com
+
+#include "AllocCounter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace{
+  std::atomic<unsigned long long> nAllocs(0);
+}
+
+namespace AllocCounter{
+  unsigned long long GetNAllocs(){ return nAllocs.load(); }
+}
+
+#ifdef COUNT_ALLOCS
+void* operator new(std::size_t size){
+  ++nAllocs;
+  void* p = std::malloc(size ? size : 1);
+  if (!p) throw std::bad_alloc();
+  return p;
+}
+
+void* operator new[](std::size_t size){
+  return ::operator new(size);
+}
+
+void operator delete(void* p) noexcept{
+  std::free(p);
+}
+
+void operator delete[](void* p) noexcept{
+  std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept{
+  std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept{
+  std::free(p);
+}
+#endif
@@ -0,0 +1,14 @@
+//File: AllocCounter.h
+//Info: Counts calls to the global operator new when the package is configured with -DCOUNT_ALLOCS=ON, so heap traffic per entry can be compared between builds.
+//      Without the option nothing is replaced and the count stays at zero.
+//
+//Author: David Last dlast@sas.upenn.edu/lastd44@gmail.com
+
+#ifndef ALLOCCOUNTER_H
+#define ALLOCCOUNTER_H
+
+namespace AllocCounter{
+  unsigned long long GetNAllocs();
+}
+
+#endif
@@ -0,0 +1,39 @@
+//File: BranchHandle.cpp
+//Info: See BranchHandle.h.
+//
+//Author: David Last dlast@sas.upenn.edu/lastd44@gmail.com
+
+#include "BranchHandle.h"
+#include <iostream>
+#include <stdexcept>
+
+BranchHandle::BranchHandle(TTree* tree, std::string name, bool optional): fTree(tree), fName(name), fLeaf(NULL), fTreeNumber(-1), fEntry(-1), fLocalEntry(-1), fOptional(optional), fResolved(false), fUsed(false) {}
+
+void BranchHandle::Resolve(){
+  fLeaf = fTree->GetLeaf(fName.c_str());
+  if (!fLeaf && !fOptional) throw std::runtime_error("No branch "+fName+" in tree "+std::string(fTree->GetName())+" (file number "+std::to_string(fTree->GetTreeNumber())+").");
+  if (!fLeaf && !fResolved) std::cout << "No branch " << fName << " in the input. It is optional, so reading it as 0." << std::endl;
+  //A switched-off branch never reads a new entry, so every entry would see whatever it last held
+  if (fLeaf && !fTree->GetBranchStatus(fName.c_str())) throw std::runtime_error("Branch "+fName+" is read but switched off. Add it to the branch whitelist.");
+  fTreeNumber = fTree->GetTreeNumber();
+  fResolved = true;
+}
+
+TLeaf* BranchHandle::Load(Long64_t entry){
+  if (!fTree){
+    if (fOptional) return NULL;
+    throw std::runtime_error("Branch "+fName+" was read, but there is no input tree to read it from.");
+  }
+  //Same entry, same file and nobody has moved the branch since: the leaf already holds this entry
+  if (entry == fEntry && fLeaf && fTree->GetTreeNumber() == fTreeNumber && fLeaf->GetBranch()->GetReadEntry() == fLocalEntry) return fLeaf;
+  //For a TChain this opens the right file and gives the entry within it; the leaf of the previous file is stale after a switch
+  Long64_t localEntry = fTree->LoadTree(entry);
+  if (!fResolved || fTree->GetTreeNumber() != fTreeNumber) Resolve();
+  if (!fLeaf) return NULL;
+  TBranch* branch = fLeaf->GetBranch();
+  if (branch->GetReadEntry() != localEntry) branch->GetEntry(localEntry);
+  fEntry = entry;
+  fLocalEntry = localEntry;
+  fUsed = true;
+  return fLeaf;
+}
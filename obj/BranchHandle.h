@@ -0,0 +1,65 @@
+//File: BranchHandle.h
+//Info: Typed handle onto one branch of a TTree/TChain. The name is resolved to a TLeaf once, and again only when the chain moves to another file,
+//      so getters read the leaf directly instead of handing the ChainWrapper a string to look up on every call.
+//      Reading a branch the input doesn't have throws std::runtime_error naming it, unless the handle was declared optional, in which case it reads as 0.
+//      So does reading a branch that is switched off (e.g. left out of a branch whitelist).
+//
+//Author: David Last dlast@sas.upenn.edu/lastd44@gmail.com
+
+#ifndef BRANCHHANDLE_H
+#define BRANCHHANDLE_H
+
+#include "TTree.h"
+#include "TLeaf.h"
+#include "TBranch.h"
+#include <string>
+#include <algorithm>
+
+class BranchHandle{
+ private:
+  TTree* fTree;
+  std::string fName;
+  TLeaf* fLeaf;
+  int fTreeNumber;
+  Long64_t fEntry;
+  Long64_t fLocalEntry;
+  bool fOptional;
+  bool fResolved;
+  bool fUsed;
+
+  void Resolve();
+
+ public:
+  //CTOR
+  //optional is for branches some inputs legitimately lack (e.g. truth branches in data)
+  BranchHandle(TTree* tree=NULL, std::string name="", bool optional=false);
+
+  //Makes entry current in the branch (switching files if needed) and returns the leaf, or NULL if an optional branch doesn't exist.
+  //Asking again for the entry already loaded skips the chain entirely.
+  TLeaf* Load(Long64_t entry);
+
+  double GetValue(Long64_t entry, int index=0){
+    TLeaf* leaf = Load(entry);
+    return leaf ? leaf->GetValue(index) : 0.0;
+  };
+  int GetInt(Long64_t entry, int index=0){ return (int)GetValue(entry, index); };
+  //Reads the first n values of the leaf into out with a single Load, for array branches. Returns how many were read (fewer if the leaf is shorter);
+  //out past that is left alone.
+  template <typename T> int GetArray(Long64_t entry, T* out, int n){
+    TLeaf* leaf = Load(entry);
+    int nRead = leaf ? std::min(n, leaf->GetLen()) : 0;
+    for (int index=0; index < nRead; ++index) out[index] = (T)leaf->GetValue(index);
+    return nRead;
+  };
+  int GetLen(Long64_t entry){
+    TLeaf* leaf = Load(entry);
+    return leaf ? leaf->GetLen() : 0;
+  };
+
+  const std::string& GetName() const { return fName; };
+  bool IsOptional() const { return fOptional; };
+  //True once an entry has been read through this handle
+  bool IsUsed() const { return fUsed; };
+};
+
+#endif
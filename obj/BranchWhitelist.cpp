@@ -0,0 +1,100 @@
+//File: BranchWhitelist.cpp
+//Info: See BranchWhitelist.h.
+//
+//Author: David Last dlast@sas.upenn.edu/lastd44@gmail.com
+
+#include "BranchWhitelist.h"
+#include "TBranch.h"
+#include "TObjArray.h"
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iostream>
+
+namespace BranchWhitelist{
+
+  std::vector<std::string> GetReadBranches(TTree* chain){
+    std::vector<std::string> branches;
+    TTree* tree = chain ? chain->GetTree() : NULL;
+    if (!tree) return branches;
+    TObjArray* list = tree->GetListOfBranches();
+    for (int index=0; index < list->GetEntries(); ++index){
+      TBranch* branch = (TBranch*)list->At(index);
+      if (branch->GetReadEntry() >= 0) branches.push_back(branch->GetName());
+    }
+    return branches;
+  }
+
+  Recorder::Recorder(TChain* chain): fChain(chain), fTreeFirst(0), fTreeLast(-1) {
+    //Makes the chain work out where each file starts
+    if (fChain) fChain->GetEntries();
+  }
+
+  void Recorder::Collect(){
+    std::vector<std::string> read = BranchWhitelist::GetReadBranches(fChain);
+    fBranches.insert(read.begin(), read.end());
+  }
+
+  void Recorder::SetEntry(Long64_t entry){
+    if (!fChain || (entry >= fTreeFirst && entry < fTreeLast)) return;
+    Collect();
+    Long64_t* offsets = fChain->GetTreeOffset();
+    int nTrees = fChain->GetNtrees();
+    if (!offsets || nTrees == 0){
+      //No file boundaries to go on, so collect on every entry
+      fTreeFirst = entry;
+      fTreeLast = entry+1;
+      return;
+    }
+    int tree = std::upper_bound(offsets, offsets+nTrees+1, entry) - offsets - 1;
+    if (tree < 0 || tree >= nTrees){
+      fTreeFirst = entry;
+      fTreeLast = entry+1;
+      return;
+    }
+    fTreeFirst = offsets[tree];
+    fTreeLast = offsets[tree+1];
+  }
+
+  std::vector<std::string> Recorder::GetReadBranches(){
+    Collect();
+    return std::vector<std::string>(fBranches.begin(), fBranches.end());
+  }
+
+  bool Write(std::string path, const std::vector<std::string>& branches){
+    std::ofstream out(path.c_str());
+    if (!out.is_open()){
+      std::cout << "Couldn't open branch whitelist " << path << " for writing." << std::endl;
+      return false;
+    }
+    out << "#Branches read during a recording run of EventLoop" << std::endl;
+    for (const auto& name: branches) out << name << std::endl;
+    return true;
+  }
+
+  std::vector<std::string> Read(std::string path){
+    std::vector<std::string> branches;
+    std::ifstream in(path.c_str());
+    if (!in.is_open()){
+      std::cout << "Couldn't open branch whitelist " << path << std::endl;
+      return branches;
+    }
+    std::string line;
+    while (std::getline(in, line)){
+      line.erase(std::remove_if(line.begin(), line.end(), ::isspace), line.end());
+      if (line.empty() || line[0] == '#') continue;
+      branches.push_back(line);
+    }
+    return branches;
+  }
+
+  void Apply(TTree* chain, const std::vector<std::string>& branches, Long64_t cacheSize){
+    if (!chain || branches.empty()) return;
+    chain->SetBranchStatus("*",false);
+    chain->SetCacheSize(cacheSize);
+    for (const auto& name: branches){
+      chain->SetBranchStatus(name.c_str(),true);
+      chain->AddBranchToCache(name.c_str(),true);
+    }
+  }
+}
@@ -0,0 +1,51 @@
+//File: BranchWhitelist.h
+//Info: Branch pruning for the MasterAnaDev chain. A short recording run notes every branch that was actually read and writes them to a whitelist;
+//      later runs switch every other branch off and put only the listed ones in the TTreeCache, so only the baskets that are needed get fetched and decompressed.
+//      The whitelist is one branch name per line ('#' starts a comment), so it can be edited by hand.
+//
+//Author: David Last dlast@sas.upenn.edu/lastd44@gmail.com
+
+#ifndef BRANCHWHITELIST_H
+#define BRANCHWHITELIST_H
+
+#include "TTree.h"
+#include "TChain.h"
+#include <string>
+#include <vector>
+#include <set>
+
+namespace BranchWhitelist{
+  //Top-level branches of the chain's current tree that have loaded an entry, by anyone (BranchHandles, the ChainWrapper, PlotUtils functions).
+  //Only covers the file the chain is in now; use a Recorder for a whole run.
+  std::vector<std::string> GetReadBranches(TTree* chain);
+
+  //GetReadBranches over every file a chain goes through. Tell it each entry before anything reads it: when the entry is in another file,
+  //the branches read in the file being left are collected while it is still loaded.
+  class Recorder{
+  private:
+    TChain* fChain;
+    //Entries of the file the chain is in
+    Long64_t fTreeFirst;
+    Long64_t fTreeLast;
+    std::set<std::string> fBranches;
+
+    void Collect();
+
+  public:
+    //CTOR
+    Recorder(TChain* chain);
+
+    void SetEntry(Long64_t entry);
+    //Everything read so far, the current file included, sorted
+    std::vector<std::string> GetReadBranches();
+  };
+
+  bool Write(std::string path, const std::vector<std::string>& branches);
+  std::vector<std::string> Read(std::string path);
+
+  //SetBranchStatus("*",0) then re-enables and caches each listed branch. The chain keeps these settings across file transitions.
+  //A BranchHandle that later resolves a branch this switched off throws, so a stale whitelist can't silently freeze a branch.
+  void Apply(TTree* chain, const std::vector<std::string>& branches, Long64_t cacheSize=100000000);
+}
+
+#endif
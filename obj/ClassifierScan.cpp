@@ -0,0 +1,154 @@
+//File: ClassifierScan.cpp
+//Info: Single pass classifier threshold scan. See ClassifierScan.h.
+//
+//Author: David Last dlast@sas.upenn.edu/lastd44@gmail.com
+
+#include "ClassifierScan.h"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <cmath>
+
+namespace NeutronCandidates{
+
+  ClassifierScan::ClassifierScan(): fFinalized(false) {}
+
+  ClassifierScan::ClassifierScan(std::vector<double> angleMins, std::vector<double> angleMaxs, std::vector<double> EMins, std::vector<double> ZMins):
+    fAngleMins(angleMins), fAngleMaxs(angleMaxs), fEMins(EMins), fZMins(ZMins), fFinalized(false) {
+    std::sort(fAngleMins.begin(), fAngleMins.end());
+    std::sort(fAngleMaxs.begin(), fAngleMaxs.end());
+    std::sort(fEMins.begin(), fEMins.end());
+    std::sort(fZMins.begin(), fZMins.end());
+  }
+
+  bool ClassifierScan::ReadGrid(std::string path){
+    std::ifstream in(path.c_str());
+    if (!in.is_open()){
+      std::cout << "Couldn't open classifier grid " << path << std::endl;
+      return false;
+    }
+    std::map<std::string, std::vector<double>> thresholds;
+    std::string line;
+    while (std::getline(in, line)){
+      std::istringstream tokens(line);
+      std::string name;
+      double value;
+      if (!(tokens >> name) || name[0] == '#') continue;
+      while (tokens >> value) thresholds[name].push_back(value);
+    }
+    if (thresholds["angleMin"].empty() || thresholds["angleMax"].empty() || thresholds["E"].empty() || thresholds["Z"].empty()){
+      std::cout << "Classifier grid " << path << " needs angleMin, angleMax, E and Z lines." << std::endl;
+      return false;
+    }
+    *this = ClassifierScan(thresholds["angleMin"], thresholds["angleMax"], thresholds["E"], thresholds["Z"]);
+    return true;
+  }
+
+  void ClassifierScan::Fill(const NeutCandView& cand, int intType, int parentBin){
+    std::pair<int,int> category(intType, parentBin);
+    ++fNCands[category];
+    if (cand.GetIs3D() != 1) return;
+
+    //Points passing each test form a contiguous run of the sorted thresholds
+    double angle = cand.GetAngleToFP();
+    int nAngleMins = std::lower_bound(fAngleMins.begin(), fAngleMins.end(), angle) - fAngleMins.begin();
+    int firstAngleMax = std::upper_bound(fAngleMaxs.begin(), fAngleMaxs.end(), angle) - fAngleMaxs.begin();
+    int nEMins = std::upper_bound(fEMins.begin(), fEMins.end(), cand.GetTotalE()) - fEMins.begin();
+    int nZMins = std::upper_bound(fZMins.begin(), fZMins.end(), fabs(cand.GetFlightPathZ())) - fZMins.begin();
+    if (nAngleMins == 0 || firstAngleMax == (int)fAngleMaxs.size() || nEMins == 0 || nZMins == 0) return;
+
+    std::vector<unsigned long long>& counts = fCounts[category];
+    if (counts.empty()) counts.assign(GetNGridPoints(), 0);
+    ++counts[GetGridIndex(nAngleMins-1, firstAngleMax, nEMins-1, nZMins-1)];
+  }
+
+  void ClassifierScan::Add(const ClassifierScan& other){
+    for (const auto& category: other.fNCands) fNCands[category.first] += category.second;
+    for (const auto& category: other.fCounts){
+      std::vector<unsigned long long>& counts = fCounts[category.first];
+      if (counts.empty()) counts.assign(GetNGridPoints(), 0);
+      for (unsigned int index=0; index < counts.size(); ++index) counts[index] += category.second[index];
+    }
+  }
+
+  void ClassifierScan::Finalize(){
+    if (fFinalized) return;
+    int nAngleMins = fAngleMins.size();
+    int nAngleMaxs = fAngleMaxs.size();
+    int nEMins = fEMins.size();
+    int nZMins = fZMins.size();
+    for (auto& category: fCounts){
+      std::vector<unsigned long long>& counts = category.second;
+      //A corner passes every point with a lower or equal angleMin, EMin and ZMin and a higher or equal angleMax
+      for (int iMin=nAngleMins-2; iMin >= 0; --iMin)
+	for (int iMax=0; iMax < nAngleMaxs; ++iMax)
+	  for (int iE=0; iE < nEMins; ++iE)
+	    for (int iZ=0; iZ < nZMins; ++iZ) counts[GetGridIndex(iMin,iMax,iE,iZ)] += counts[GetGridIndex(iMin+1,iMax,iE,iZ)];
+      for (int iMin=0; iMin < nAngleMins; ++iMin)
+	for (int iMax=1; iMax < nAngleMaxs; ++iMax)
+	  for (int iE=0; iE < nEMins; ++iE)
+	    for (int iZ=0; iZ < nZMins; ++iZ) counts[GetGridIndex(iMin,iMax,iE,iZ)] += counts[GetGridIndex(iMin,iMax-1,iE,iZ)];
+      for (int iMin=0; iMin < nAngleMins; ++iMin)
+	for (int iMax=0; iMax < nAngleMaxs; ++iMax)
+	  for (int iE=nEMins-2; iE >= 0; --iE)
+	    for (int iZ=0; iZ < nZMins; ++iZ) counts[GetGridIndex(iMin,iMax,iE,iZ)] += counts[GetGridIndex(iMin,iMax,iE+1,iZ)];
+      for (int iMin=0; iMin < nAngleMins; ++iMin)
+	for (int iMax=0; iMax < nAngleMaxs; ++iMax)
+	  for (int iE=0; iE < nEMins; ++iE)
+	    for (int iZ=nZMins-2; iZ >= 0; --iZ) counts[GetGridIndex(iMin,iMax,iE,iZ)] += counts[GetGridIndex(iMin,iMax,iE,iZ+1)];
+    }
+    fFinalized = true;
+  }
+
+  void ClassifierScan::Write(std::ostream& out){
+    Finalize();
+    out << "#intType parentBin angleMin angleMax EMin ZMin nPassing nCands" << std::endl;
+    for (const auto& category: fNCands){
+      auto found = fCounts.find(category.first);
+      for (int iMin=0; iMin < (int)fAngleMins.size(); ++iMin)
+	for (int iMax=0; iMax < (int)fAngleMaxs.size(); ++iMax)
+	  for (int iE=0; iE < (int)fEMins.size(); ++iE)
+	    for (int iZ=0; iZ < (int)fZMins.size(); ++iZ){
+	      unsigned long long nPassing = (found == fCounts.end()) ? 0 : found->second[GetGridIndex(iMin,iMax,iE,iZ)];
+	      out << category.first.first << " " << category.first.second << " " << fAngleMins[iMin] << " " << fAngleMaxs[iMax] << " " << fEMins[iE] << " " << fZMins[iZ] << " " << nPassing << " " << category.second << std::endl;
+	    }
+    }
+  }
+
+  bool ClassifierScan::AddTable(std::string path){
+    std::ifstream in(path.c_str());
+    if (!in.is_open()){
+      std::cout << "Couldn't open classifier scan " << path << std::endl;
+      return false;
+    }
+    Finalize();
+    std::map<std::pair<int,int>, int> nRows;
+    std::string line;
+    while (std::getline(in, line)){
+      if (line.empty() || line[0] == '#') continue;
+      std::istringstream tokens(line);
+      int intType, parentBin;
+      double angleMin, angleMax, EMin, ZMin;
+      unsigned long long nPassing, nCands;
+      if (!(tokens >> intType >> parentBin >> angleMin >> angleMax >> EMin >> ZMin >> nPassing >> nCands)){
+	std::cout << "Couldn't read line \"" << line << "\" of classifier scan " << path << std::endl;
+	return false;
+      }
+      std::pair<int,int> category(intType, parentBin);
+      int row = nRows[category]++;
+      if (row >= GetNGridPoints()) break;
+      std::vector<unsigned long long>& counts = fCounts[category];
+      if (counts.empty()) counts.assign(GetNGridPoints(), 0);
+      counts[row] += nPassing;
+      if (row == 0) fNCands[category] += nCands;
+    }
+    for (const auto& category: nRows){
+      if (category.second != GetNGridPoints()){
+	std::cout << "Classifier scan " << path << " isn't over this grid." << std::endl;
+	return false;
+      }
+    }
+    return true;
+  }
+}
@@ -0,0 +1,60 @@
+//File: ClassifierScan.h
+//Info: Scans a grid of NeutCand classifier thresholds (angle window, blob energy, flight path |Z|) in one pass over the candidates.
+//      Each candidate is placed once at the corner of the box of grid points it passes; Finalize() turns those corners into per-point pass counts with cumulative sums,
+//      so the per-candidate cost is a few binary searches no matter how big the grid is.
+//      Counts are kept per (interaction type, parent PID bin) category so purity/efficiency surfaces come out of a single job.
+//
+//Author: David Last dlast@sas.upenn.edu/lastd44@gmail.com
+
+#ifndef CLASSIFIERSCAN_H
+#define CLASSIFIERSCAN_H
+
+#include "NeutCands.h"
+#include <map>
+#include <string>
+#include <vector>
+#include <utility>
+#include <ostream>
+
+namespace NeutronCandidates{
+
+  class ClassifierScan{
+  private:
+    //Thresholds, each sorted ascending
+    std::vector<double> fAngleMins;
+    std::vector<double> fAngleMaxs;
+    std::vector<double> fEMins;
+    std::vector<double> fZMins;
+
+    //Keyed by (interaction type, parent PID bin). fCounts holds corners until Finalize() and pass counts after.
+    std::map<std::pair<int,int>, std::vector<unsigned long long>> fCounts;
+    std::map<std::pair<int,int>, unsigned long long> fNCands;
+    bool fFinalized;
+
+    int GetGridIndex(int iAngleMin, int iAngleMax, int iE, int iZ) const { return ((iAngleMin*fAngleMaxs.size() + iAngleMax)*fEMins.size() + iE)*fZMins.size() + iZ; };
+
+  public:
+    //CTORS
+    ClassifierScan();
+    ClassifierScan(std::vector<double> angleMins, std::vector<double> angleMaxs, std::vector<double> EMins, std::vector<double> ZMins);
+
+    //Grid file has one line per threshold: a name (angleMin, angleMax, E, Z) followed by its values. Returns false if any is missing.
+    bool ReadGrid(std::string path);
+
+    int GetNGridPoints() const { return fAngleMins.size()*fAngleMaxs.size()*fEMins.size()*fZMins.size(); };
+
+    //Same tests as NeutCand::GetClassifier: Is3D==1, angleMin < angle < angleMax, E >= EMin, |flight path Z| >= ZMin
+    void Fill(const NeutCandView& cand, int intType, int parentBin);
+    //Adds the counts of a scan over the same grid, e.g. one filled by another thread. Both must still be unfinalized.
+    void Add(const ClassifierScan& other);
+    void Finalize();
+
+    //One line per (category, grid point): intType parentBin angleMin angleMax EMin ZMin nPassing nCands
+    void Write(std::ostream& out);
+    //Adds a table that Write() made over the same grid, e.g. in one process of a --processes run. Rows are matched by their order in each category,
+    //so set the grid up first with ReadGrid() from the same file. Finalizes this scan. Returns false if the file can't be read or has another grid.
+    bool AddTable(std::string path);
+  };
+}
+
+#endif
@@ -0,0 +1,205 @@
+//File: CutFlow.h
+//Info: Selection as a list of named cut nodes, each with a declared cost class, that all have to pass.
+//      For the first nWarmUp events every node runs on every event and is timed, which gives each node's unconditional rejection rate and cost.
+//      After that, each run of commutative nodes is put in order of time per rejected event, so cheap cuts that reject a lot run first. Evaluation then
+//      stops at the first failing node. The warm-up events are replayed in the new order, so the cut-flow table is counted in one consistent order.
+//
+//Author: David Last dlast@sas.upenn.edu/lastd44@gmail.com
+
+#ifndef CUTFLOW_H
+#define CUTFLOW_H
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <vector>
+
+template <typename EVENT> class CutFlow{
+ public:
+  //Rough cost before anything is measured, and the tie-breaker after
+  enum CostClass{ kScalar, kVector, kTruth };
+
+ private:
+  struct Node{
+    std::string name;
+    int costClass;
+    std::function<bool(const EVENT&)> pass;
+    //Non-commutative nodes stay where they were declared and nothing is moved across them
+    bool commutative;
+    //Warm-up: every node on every event
+    unsigned long long nWarmPassed;
+    double warmSeconds;
+    //Events that reached and passed the node in the current order
+    unsigned long long nReached;
+    unsigned long long nPassed;
+  };
+
+  std::vector<Node> fNodes;
+  std::vector<int> fOrder;
+  unsigned long long fNWarmUp;
+  unsigned long long fNWarmEvents;
+  unsigned long long fNEvents;
+  unsigned long long fNPassed;
+  //One bit per node for each warm-up event, replayed once the order is fixed
+  std::vector<unsigned long long> fWarmMasks;
+  bool fOrdered;
+
+  //Mean time per rejected event. A node that never rejected goes last.
+  double GetRank(const Node& node) const {
+    double rejection = (fNWarmEvents > 0) ? 1.0 - (double)node.nWarmPassed/(double)fNWarmEvents : 0.0;
+    if (rejection <= 0.0) return std::numeric_limits<double>::infinity();
+    return node.warmSeconds/(double)fNWarmEvents/rejection;
+  };
+
+  void ReplayWarmUp(){
+    for (auto mask: fWarmMasks){
+      if (Replay(mask)) ++fNPassed;
+    }
+    fWarmMasks.clear();
+    fWarmMasks.shrink_to_fit();
+    fOrdered = true;
+  };
+
+  bool Replay(unsigned long long mask){
+    for (int index: fOrder){
+      Node& node = fNodes[index];
+      ++node.nReached;
+      if (!(mask & (1ULL << index))) return false;
+      ++node.nPassed;
+    }
+    return true;
+  };
+
+ public:
+  //CTOR
+  CutFlow(unsigned long long nWarmUp=1000): fNWarmUp(nWarmUp), fNWarmEvents(0), fNEvents(0), fNPassed(0), fOrdered(false) {};
+
+  //At most 64 nodes. Nodes run in declaration order until the warm-up is over.
+  void AddCut(std::string name, int costClass, std::function<bool(const EVENT&)> pass, bool commutative=true){
+    Node node;
+    node.name = name;
+    node.costClass = costClass;
+    node.pass = pass;
+    node.commutative = commutative;
+    node.nWarmPassed = 0;
+    node.warmSeconds = 0.0;
+    node.nReached = 0;
+    node.nPassed = 0;
+    fOrder.push_back(fNodes.size());
+    fNodes.push_back(node);
+  };
+
+  bool Passes(const EVENT& evt){
+    ++fNEvents;
+    if (!fOrdered){
+      unsigned long long mask = 0;
+      for (unsigned int index=0; index < fNodes.size(); ++index){
+	Node& node = fNodes[index];
+	auto start = std::chrono::steady_clock::now();
+	bool passed = node.pass(evt);
+	node.warmSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+	if (passed){
+	  ++node.nWarmPassed;
+	  mask |= (1ULL << index);
+	}
+      }
+      ++fNWarmEvents;
+      fWarmMasks.push_back(mask);
+      bool passedAll = (mask == ((fNodes.size() >= 64) ? ~0ULL : (1ULL << fNodes.size())-1));
+      if (fNWarmEvents >= fNWarmUp) Finish();
+      return passedAll;
+    }
+    for (int index: fOrder){
+      Node& node = fNodes[index];
+      ++node.nReached;
+      if (!node.pass(evt)) return false;
+      ++node.nPassed;
+    }
+    ++fNPassed;
+    return true;
+  };
+
+  //The same decision as Passes() in the current order, but neither counted nor timed, e.g. for shifted universes whose entries the central
+  //value already put through Passes()
+  bool Evaluate(const EVENT& evt) const {
+    for (int index: fOrder){
+      if (!fNodes[index].pass(evt)) return false;
+    }
+    return true;
+  };
+
+  //Fixes the order from the warm-up measurements and replays the warm-up events. Called by Passes() at the end of the warm-up;
+  //call it by hand at the end of the job in case the warm-up never finished.
+  void Finish(){
+    if (fOrdered) return;
+    //Sort each run of commutative nodes between the non-commutative ones
+    unsigned int begin = 0;
+    while (begin < fOrder.size()){
+      unsigned int end = begin;
+      while (end < fOrder.size() && fNodes[fOrder[end]].commutative) ++end;
+      std::stable_sort(fOrder.begin()+begin, fOrder.begin()+end, [this](int a, int b){
+	  double rankA = GetRank(fNodes[a]);
+	  double rankB = GetRank(fNodes[b]);
+	  if (rankA != rankB) return rankA < rankB;
+	  return fNodes[a].costClass < fNodes[b].costClass;
+	});
+      begin = end+1;
+    }
+    ReplayWarmUp();
+  };
+
+  //Takes an order found by another, identically declared CutFlow (e.g. the thread that ran the warm-up) instead of measuring one, so the two
+  //can be added. Any warm-up events seen so far are replayed in it. Returns false, changing nothing, if this flow already fixed a different order.
+  bool SetOrder(const std::vector<int>& order){
+    if (fOrdered || order.size() != fOrder.size()) return order == fOrder;
+    fOrder = order;
+    ReplayWarmUp();
+    return true;
+  };
+  const std::vector<int>& GetOrder() const { return fOrder; };
+  bool IsOrdered() const { return fOrdered; };
+
+  //Adds the counts of an identically declared CutFlow, e.g. another thread's. Both must be finished in the same order (see SetOrder), since the
+  //reached and passed counts depend on it; returns false and adds nothing otherwise.
+  bool Add(const CutFlow& other){
+    if (!fOrdered || !other.fOrdered || fOrder != other.fOrder) return false;
+    for (unsigned int index=0; index < fNodes.size() && index < other.fNodes.size(); ++index){
+      fNodes[index].nWarmPassed += other.fNodes[index].nWarmPassed;
+      fNodes[index].warmSeconds += other.fNodes[index].warmSeconds;
+      fNodes[index].nReached += other.fNodes[index].nReached;
+      fNodes[index].nPassed += other.fNodes[index].nPassed;
+    }
+    fNWarmEvents += other.fNWarmEvents;
+    fNEvents += other.fNEvents;
+    fNPassed += other.fNPassed;
+    return true;
+  };
+
+  unsigned long long GetNEvents() const { return fNEvents; };
+  unsigned long long GetNPassed() const { return fNPassed; };
+
+  //One row per node in run order: events reaching it, passing it, its efficiency there, and its warm-up pass rate and mean time
+  void Print(std::ostream& out) const {
+    std::ios::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+    out << std::left << std::setw(20) << "Cut" << std::right << std::setw(6) << "Cost" << std::setw(14) << "Reached" << std::setw(14) << "Passed"
+	<< std::setw(10) << "Eff." << std::setw(12) << "Warm eff." << std::setw(14) << "Warm t [us]" << std::endl;
+    for (int index: fOrder){
+      const Node& node = fNodes[index];
+      out << std::left << std::setw(20) << node.name << std::right << std::setw(6) << node.costClass << std::setw(14) << node.nReached << std::setw(14) << node.nPassed
+	  << std::fixed << std::setprecision(4)
+	  << std::setw(10) << ((node.nReached > 0) ? (double)node.nPassed/(double)node.nReached : 0.0)
+	  << std::setw(12) << ((fNWarmEvents > 0) ? (double)node.nWarmPassed/(double)fNWarmEvents : 0.0)
+	  << std::setprecision(3) << std::setw(14) << ((fNWarmEvents > 0) ? 1.0e6*node.warmSeconds/(double)fNWarmEvents : 0.0) << std::endl;
+      out.flags(flags);
+      out.precision(precision);
+    }
+    out << "Passed all cuts: " << fNPassed << " of " << fNEvents << std::endl;
+  };
+};
+
+#endif
@@ -0,0 +1,33 @@
+//File: EMBlobSummary.cpp
+//Info: Fused mask-and-sum over the EM blob arrays. See EMBlobSummary.h.
+//
+//Author: David Last dlast@sas.upenn.edu/lastd44@gmail.com
+
+#include "EMBlobSummary.h"
+
+EMBlobSummary SumEMBlobs(int n, const double* startZ, const double* energy, const int* nHits, double zMin){
+  double laneBlobs[4] = {0.0,0.0,0.0,0.0};
+  double laneE[4] = {0.0,0.0,0.0,0.0};
+  double laneHits[4] = {0.0,0.0,0.0,0.0};
+  int nFull = n - n%4;
+  for (int index=0; index < nFull; index+=4){
+    for (int lane=0; lane < 4; ++lane){
+      //The mask is 1.0 or 0.0, so every lane does the same arithmetic whether or not the blob passes
+      double mask = (double)(startZ[index+lane] > zMin);
+      laneBlobs[lane] += mask;
+      laneE[lane] += mask*energy[index+lane];
+      laneHits[lane] += mask*(double)nHits[index+lane];
+    }
+  }
+  for (int index=nFull; index < n; ++index){
+    double mask = (double)(startZ[index] > zMin);
+    laneBlobs[0] += mask;
+    laneE[0] += mask*energy[index];
+    laneHits[0] += mask*(double)nHits[index];
+  }
+  EMBlobSummary summary;
+  summary.nBlobs = (laneBlobs[0]+laneBlobs[1])+(laneBlobs[2]+laneBlobs[3]);
+  summary.totalE = (laneE[0]+laneE[1])+(laneE[2]+laneE[3]);
+  summary.nHits = (laneHits[0]+laneHits[1])+(laneHits[2]+laneHits[3]);
+  return summary;
+}
@@ -0,0 +1,19 @@
+//File: EMBlobSummary.h
+//Info: Reduction of the non-vertex isolated EM blobs used by the Tejin CCQE cuts: how many start downstream of a z cut, and their summed energy and hits.
+//
+//Author: David Last dlast@sas.upenn.edu/lastd44@gmail.com
+
+#ifndef EMBLOBSUMMARY_H
+#define EMBLOBSUMMARY_H
+
+struct EMBlobSummary{
+  double nBlobs;
+  double totalE;
+  double nHits;
+};
+
+//Sums the blobs with startZ > zMin. Branchless over four independent lanes so the loop vectorizes; the lanes are added at the end,
+//so totalE can differ from a strictly sequential sum in the last bits.
+EMBlobSummary SumEMBlobs(int n, const double* startZ, const double* energy, const int* nHits, double zMin);
+
+#endif
@@ -0,0 +1,96 @@
+//File: EntryQueue.cpp
+//Info: See EntryQueue.h.
+//
+//Author: David Last dlast@sas.upenn.edu/lastd44@gmail.com
+
+#include "EntryQueue.h"
+#include "TTree.h"
+#include <algorithm>
+
+EntryQueue::EntryQueue(const std::vector<EntryRange>& ranges, int nThreads): fRanges(std::max(nThreads,1)), fLocks(std::max(nThreads,1)){
+  //Contiguous blocks of about the same number of ranges, in entry order
+  int nBlocks = fRanges.size();
+  for (unsigned int index=0; index < ranges.size(); ++index) fRanges[(index*nBlocks)/ranges.size()].push_back(ranges[index]);
+}
+
+bool EntryQueue::Next(int thread, EntryRange& range){
+  int nBlocks = fRanges.size();
+  {
+    std::lock_guard<std::mutex> lock(fLocks[thread]);
+    if (!fRanges[thread].empty()){
+      range = fRanges[thread].front();
+      fRanges[thread].pop_front();
+      return true;
+    }
+  }
+  for (int offset=1; offset < nBlocks; ++offset){
+    int victim = (thread+offset)%nBlocks;
+    std::lock_guard<std::mutex> lock(fLocks[victim]);
+    if (!fRanges[victim].empty()){
+      range = fRanges[victim].back();
+      fRanges[victim].pop_back();
+      return true;
+    }
+  }
+  return false;
+}
+
+std::vector<EntryRange> EntryQueue::GetClusterRanges(TChain* chain, Long64_t first, Long64_t last, Long64_t minEntries){
+  std::vector<EntryRange> ranges;
+  if (first >= last) return ranges;
+  if (!chain){
+    for (Long64_t rangeFirst=first; rangeFirst < last; rangeFirst += minEntries) ranges.push_back(EntryRange{rangeFirst, std::min(rangeFirst+minEntries,last)});
+    return ranges;
+  }
+
+  //Every cluster start inside (first, last), plus the file boundaries, which are always cluster starts
+  std::vector<Long64_t> starts;
+  chain->GetEntries();
+  Long64_t* offsets = chain->GetTreeOffset();
+  if (!offsets || chain->GetNtrees() == 0){
+    ranges.push_back(EntryRange{first, last});
+    return ranges;
+  }
+  for (int iTree=0; iTree < chain->GetNtrees(); ++iTree){
+    Long64_t treeFirst = offsets[iTree];
+    Long64_t treeLast = offsets[iTree+1];
+    if (treeLast <= first || treeFirst >= last) continue;
+    starts.push_back(treeFirst);
+    if (chain->LoadTree(treeFirst) < 0) continue;
+    TTree::TClusterIterator clusters = chain->GetTree()->GetClusterIterator(0);
+    Long64_t start;
+    while ((start = clusters()) < treeLast-treeFirst) starts.push_back(treeFirst+start);
+  }
+  starts.push_back(last);
+  std::sort(starts.begin(), starts.end());
+
+  Long64_t rangeFirst = first;
+  for (auto start: starts){
+    if (start <= rangeFirst) continue;
+    bool fileBoundary = std::binary_search(offsets, offsets+chain->GetNtrees()+1, start);
+    if (start >= last || start-rangeFirst >= minEntries || fileBoundary){
+      ranges.push_back(EntryRange{rangeFirst, std::min(start,last)});
+      rangeFirst = start;
+    }
+    if (rangeFirst >= last) break;
+  }
+  return ranges;
+}
+
+EntryRange EntryQueue::GetShard(TChain* chain, Long64_t first, Long64_t last, int k, int n){
+  std::vector<EntryRange> clusters;
+  if (chain) clusters = GetClusterRanges(chain, first, last, 1);
+  //First cluster start at or after the even split point, unless that overshoots the next split point (clusters bigger than a shard), in which case
+  //the split point itself. Either way it only depends on index, so neighbouring shards agree on their shared edge.
+  auto edge = [&](int index){
+    if (index <= 0) return first;
+    if (index >= n) return last;
+    Long64_t target = first + ((last-first)*index)/n;
+    Long64_t nextTarget = first + ((last-first)*(index+1))/n;
+    for (const auto& cluster: clusters){
+      if (cluster.first >= target) return (cluster.first < nextTarget) ? cluster.first : target;
+    }
+    return target;
+  };
+  return EntryRange{edge(k), edge(k+1)};
+}
@@ -0,0 +1,43 @@
+//File: EntryQueue.h
+//Info: Hands out ranges of chain entries to the worker threads of a threaded EventLoop.
+//      Ranges follow the ROOT cluster boundaries of each file, so two threads never decompress the same basket.
+//      Each thread starts on its own contiguous block of ranges and reads it front to back; once that runs dry it steals from the back of another thread's block.
+//
+//Author: David Last dlast@sas.upenn.edu/lastd44@gmail.com
+
+#ifndef ENTRYQUEUE_H
+#define ENTRYQUEUE_H
+
+#include "TChain.h"
+#include <deque>
+#include <mutex>
+#include <vector>
+
+//Entries [first, last)
+struct EntryRange{
+  Long64_t first;
+  Long64_t last;
+};
+
+class EntryQueue{
+ private:
+  std::vector<std::deque<EntryRange>> fRanges;
+  std::vector<std::mutex> fLocks;
+
+ public:
+  //CTOR
+  EntryQueue(const std::vector<EntryRange>& ranges, int nThreads);
+
+  //False once every thread's block is empty
+  bool Next(int thread, EntryRange& range);
+
+  //Cluster-aligned ranges covering [first, last) of the chain. Neighbouring clusters in the same file are merged until a range holds at least minEntries.
+  //Without a chain (e.g. reading a skim) the ranges are just minEntries long.
+  static std::vector<EntryRange> GetClusterRanges(TChain* chain, Long64_t first, Long64_t last, Long64_t minEntries=10000);
+
+  //Shard k (counting from 0) of n of [first, last): contiguous pieces of about (last-first)/n entries, each starting on a cluster boundary.
+  //The n shards cover [first, last) exactly once. Without a chain they are split evenly.
+  static EntryRange GetShard(TChain* chain, Long64_t first, Long64_t last, int k, int n);
+};
+
+#endif
@@ -0,0 +1,54 @@
+//File: EventArena.cpp
+//Info: Bump allocator for per-entry temporaries. See EventArena.h.
+//
+//Author: David Last dlast@sas.upenn.edu/lastd44@gmail.com
+
+#include "EventArena.h"
+#include <algorithm>
+
+EventArena::EventArena(std::size_t chunkSize): fChunkSize(chunkSize), fCurrent(0), fOffset(0), fBytesUsed(0), fMaxBytesUsed(0) {}
+
+EventArena::EventArena(const EventArena& other): fChunkSize(other.fChunkSize), fCurrent(0), fOffset(0), fBytesUsed(0), fMaxBytesUsed(0) {}
+
+EventArena& EventArena::operator=(const EventArena& other){
+  if (this != &other){
+    this->Reset();
+    fChunkSize = other.fChunkSize;
+  }
+  return *this;
+}
+
+EventArena::~EventArena(){
+  for (auto chunk: fChunks) ::operator delete(chunk);
+}
+
+void EventArena::AddChunk(std::size_t minBytes){
+  std::size_t size = std::max(fChunkSize, minBytes);
+  fChunks.push_back(static_cast<char*>(::operator new(size)));
+  fChunkSizes.push_back(size);
+}
+
+void* EventArena::Allocate(std::size_t bytes, std::size_t align){
+  //Walk forward through the chunks kept from earlier entries before asking the heap for a new one
+  while (true){
+    if (fCurrent < fChunks.size()){
+      std::size_t start = (fOffset + align - 1) & ~(align - 1);
+      if (start + bytes <= fChunkSizes[fCurrent]){
+	fOffset = start + bytes;
+	fBytesUsed += bytes;
+	fMaxBytesUsed = std::max(fMaxBytesUsed, fBytesUsed);
+	return fChunks[fCurrent] + start;
+      }
+      if (fCurrent+1 == fChunks.size()) AddChunk(bytes + align);
+      ++fCurrent;
+      fOffset = 0;
+    }
+    else AddChunk(bytes + align);
+  }
+}
+
+void EventArena::Reset(){
+  fCurrent = 0;
+  fOffset = 0;
+  fBytesUsed = 0;
+}
@@ -0,0 +1,91 @@
+//File: EventArena.h
+//Info: Bump allocator for temporaries that only live for one entry of the event loop, plus an STL allocator on top of it.
+//      Memory is handed out from large chunks and only given back wholesale by Reset(), which keeps the chunks for the next entry.
+//
+//Author: David Last dlast@sas.upenn.edu/lastd44@gmail.com
+
+#ifndef EVENTARENA_H
+#define EVENTARENA_H
+
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <vector>
+
+class EventArena{
+ private:
+  std::size_t fChunkSize;
+  std::vector<char*> fChunks;
+  std::vector<std::size_t> fChunkSizes;
+  std::size_t fCurrent;
+  std::size_t fOffset;
+  std::size_t fBytesUsed;
+  std::size_t fMaxBytesUsed;
+
+  void AddChunk(std::size_t minBytes);
+
+ public:
+  //CTORS
+  EventArena(std::size_t chunkSize=64*1024);
+  //Copies start out empty; chunks are never shared between arenas
+  EventArena(const EventArena& other);
+  EventArena& operator=(const EventArena& other);
+
+  //DTOR
+  ~EventArena();
+
+  void* Allocate(std::size_t bytes, std::size_t align=alignof(std::max_align_t));
+  void Reset();
+
+  std::size_t GetBytesUsed() const { return fBytesUsed; };
+  std::size_t GetMaxBytesUsed() const { return fMaxBytesUsed; };
+  std::size_t GetNChunks() const { return fChunks.size(); };
+};
+
+//Deallocation is a no-op; everything goes away at the next EventArena::Reset(). Without an arena it falls back to the heap.
+template <typename T> class ArenaAllocator{
+ public:
+  typedef T value_type;
+
+  EventArena* fArena;
+
+  ArenaAllocator(EventArena* arena=NULL): fArena(arena) {};
+  template <typename U> ArenaAllocator(const ArenaAllocator<U>& other): fArena(other.fArena) {};
+
+  T* allocate(std::size_t n){
+    if (fArena) return static_cast<T*>(fArena->Allocate(n*sizeof(T), alignof(T)));
+    return static_cast<T*>(::operator new(n*sizeof(T)));
+  };
+  void deallocate(T* p, std::size_t){
+    if (!fArena) ::operator delete(p);
+  };
+};
+
+template <typename T, typename U> bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b){ return a.fArena == b.fArena; }
+template <typename T, typename U> bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b){ return a.fArena != b.fArena; }
+
+template <typename T> using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+//Read-only view of a per-entry array that lives somewhere else: the shared entry store, a memory-mapped skim or arena memory.
+//Good until the entry changes, like everything else drawn from the arena.
+template <typename T> class ArenaSpan{
+ private:
+  const T* fData;
+  std::size_t fSize;
+ public:
+  ArenaSpan(const T* data=NULL, std::size_t size=0): fData(data), fSize(size) {};
+  template <typename A> ArenaSpan(const std::vector<T, A>& values): fData(values.data()), fSize(values.size()) {};
+
+  const T* data() const { return fData; };
+  std::size_t size() const { return fSize; };
+  bool empty() const { return fSize == 0; };
+  const T* begin() const { return fData; };
+  const T* end() const { return fData+fSize; };
+  const T& operator[](std::size_t index) const { return fData[index]; };
+  const T& at(std::size_t index) const {
+    if (index >= fSize) throw std::out_of_range("ArenaSpan::at");
+    return fData[index];
+  };
+};
+
+#endif
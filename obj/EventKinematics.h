@@ -0,0 +1,55 @@
+//File: EventKinematics.h
+//Info: Per-universe, per-entry record of every reconstructed quantity the selection cuts and the histogram fills read.
+//      CVUniverse::FillEventKinematics() fills it through the (possibly shifted) getters one Part at a time, only the parts asked for and only once,
+//      so a cut that rejects the entry early never pays for the getters the later cuts read. The cuts are then plain functions of it.
+//      Kept trivial so it can be copied, stored in arrays or built by hand without a universe (set filled by hand then).
+//
+//Author: David Last dlast@sas.upenn.edu/lastd44@gmail.com
+
+#ifndef EVENTKINEMATICS_H
+#define EVENTKINEMATICS_H
+
+#include "EMBlobSummary.h"
+#include <type_traits>
+
+struct EventKinematics{
+  //Groups of fields filled together, roughly by which cut reads them
+  enum Part{
+    kVertex=1,      //vtx
+    kMuon=2,        //muon 4-vector, Pmu, Thetamu
+    kRecoil=4,      //recoilEGeV, EnuGeV, Q2GeV
+    kPrimary=8,     //primaryKE
+    kCounts=16,     //nTracks, nImprovedMichel, hasInteractionVertex, nDeadDiscriminators, nuHelicity
+    kEMBlobs=32,    //EMBlobs
+    kTruth=64,      //intType
+    kAll=127
+  };
+  //Parts already filled. Start every entry at 0.
+  unsigned int filled;
+
+  double vtx[3];
+  //Muon 4-vector (MeV), as returned by GetMuon4V()
+  double muonPx;
+  double muonPy;
+  double muonPz;
+  double muonE;
+  double Pmu;
+  double Thetamu;
+  double EnuGeV;
+  double Q2GeV;
+  //Whichever recoil the run selected (GetRecoilEnergyGeV() or GetDANRecoilEnergyGeV())
+  double recoilEGeV;
+  //Kinetic energy of the first FS particle. Only filled for particle cannon samples, 0 otherwise.
+  double primaryKE;
+  EMBlobSummary EMBlobs;
+  int nTracks;
+  int nImprovedMichel;
+  int hasInteractionVertex;
+  int nDeadDiscriminators;
+  int nuHelicity;
+  int intType;
+};
+
+static_assert(std::is_trivial<EventKinematics>::value, "EventKinematics must stay a trivial struct");
+
+#endif
@@ -7,39 +7,33 @@
 
 namespace NeutronCandidates{
 
-  intBranchMap GetBranchIntMap(){
-    //return {{"SetID",{"MasterAnaDev_BlobID"}},{"SetIs3D",{"MasterAnaDev_BlobIs3D"}},{"SetMCPID",{"MasterAnaDev_BlobMCPID"}},{"SetTopMCPID",{"MasterAnaDev_BlobTopMCPID"}},{"SetMCParentTrackID",{"MasterAnaDev_BlobMCParentTrackID"}},{"SetMCParentPID",{"MasterAnaDev_BlobMCParentPID"}},};
-    return {{"SetID",{"MasterAnaDev_BlobID"}},{"SetIs3D",{"MasterAnaDev_BlobIs3D"}},{"SetMCPID",{"MasterAnaDev_BlobMCPID"}},{"SetTopMCPID",{"MasterAnaDev_BlobTopMCPID"}},{"SetMCParentTrackID",{"MasterAnaDev_BlobMCParentTrackID"}},};
+  void ClassifyBlobs(int n, const int* is3D, const double* totE,
+		     const double* begX, const double* begY, const double* begZ,
+		     const double* endX, const double* endY, const double* endZ,
+		     const double* vtx, unsigned char* masks){
+    //0.2 < angle < 0.7 is cos(0.7) < cos(angle) < cos(0.2). A zero-length flight path or direction gives dot = norm = 0 and fails both, as the -9999 angle does.
+    const double cosMaxAngle = cos(0.7);
+    const double cosMinAngle = cos(0.2);
+    for (int index=0; index < n; ++index){
+      double fpX = begX[index]-vtx[0];
+      double fpY = begY[index]-vtx[1];
+      double fpZ = begZ[index]-vtx[2];
+      double dirX = endX[index]-begX[index];
+      double dirY = endY[index]-begY[index];
+      double dirZ = endZ[index]-begZ[index];
+      double dot = fpX*dirX+fpY*dirY+fpZ*dirZ;
+      double norm = sqrt((fpX*fpX+fpY*fpY+fpZ*fpZ)*(dirX*dirX+dirY*dirY+dirZ*dirZ));
+      masks[index] = (unsigned char)(is3D[index]==1)
+	| ((unsigned char)((dot > cosMaxAngle*norm) & (dot < cosMinAngle*norm)) << 1)
+	| ((unsigned char)(totE[index] >= 50.0) << 2)
+	| ((unsigned char)(fabs(fpZ) >= 100.0) << 3);
+    }
   }
 
-  doubleBranchMap GetBranchDoubleMap(){
-    return {{"SetTotE",{"MasterAnaDev_BlobTotalE"}},{"SetBegPos",{"MasterAnaDev_BlobBegX","MasterAnaDev_BlobBegY","MasterAnaDev_BlobBegZ"}},{"SetEndPos",{"MasterAnaDev_BlobEndX","MasterAnaDev_BlobEndY","MasterAnaDev_BlobEndZ"}}, };
-  }
-  
   NeutCand::NeutCand(){
     this->init();
   }
 
-  NeutCand::NeutCand(intCandData candIntData, doubleCandData candDoubleData, TVector3 vtx){
-    this->init();
-    this->SetEvtVtx(vtx);
-    for(const auto& function: candIntData){
-      if (function.first=="SetID") this->SetID(function.second);
-      else if (function.first=="SetIs3D") this->SetIs3D(function.second);
-      else if (function.first=="SetMCPID") this->SetMCPID(function.second);
-      else if (function.first=="SetTopMCPID") this->SetTopMCPID(function.second);
-      else if (function.first=="SetMCParentTrackID") this->SetMCParentTrackID(function.second);
-      else if (function.first=="SetMCParentPID") this->SetMCParentPID(function.second);
-      else continue;
-    }
-    for(const auto& function:candDoubleData){
-      if (function.first=="SetTotE") this->SetTotalE(function.second);
-      else if (function.first=="SetBegPos") this->SetBegPos(function.second);
-      else if (function.first=="SetEndPos") this->SetEndPos(function.second);
-      else continue;
-    }
-  }
-  
   void NeutCand::init(){
     TVector3 tmp;
     tmp.SetXYZ(0.0,0.0,0.0);
@@ -50,14 +44,40 @@ namespace NeutronCandidates{
     fMCParentTrackID = -999;
     fMCParentPID = -999;
     fTotE = -999.0;
-    fAngleToFP = -999.0;
     fEvtVtx=tmp;
     fBegPos=tmp;
+    fEndPos=tmp;
+    fCached = 0;
+    fLength = -999.0;
+    fVtxDist = -999.0;
+    fAngleToFP = -999.0;
     fDirection=tmp;
     fFlightPath=tmp;
     tmp.~TVector3();
   }
 
+  void NeutCand::CacheDirection(){
+    fDirection = fEndPos-fBegPos;
+    fLength = fDirection.Mag();
+    fCached |= kDirectionCached;
+  }
+
+  void NeutCand::CacheFlightPath(){
+    fFlightPath = fBegPos-fEvtVtx;
+    fVtxDist = fFlightPath.Mag();
+    fCached |= kFlightPathCached;
+  }
+
+  void NeutCand::CacheAngle(){
+    if (this->GetVtxDist() > 0 && this->GetLength() > 0){
+      fAngleToFP = fFlightPath.Angle(fDirection);
+    }
+    else {
+      fAngleToFP = -9999.0;
+    }
+    fCached |= kAngleCached;
+  }
+
   std::bitset<4> NeutCand::GetClassifier(){
     std::bitset<4> cfier{"0000"};
     if (this->GetIs3D()==1) cfier.flip(0);
@@ -67,34 +87,313 @@ namespace NeutronCandidates{
     return cfier;
   }
   
+  std::bitset<4> NeutCandView::GetClassifier() const{
+    return std::bitset<4>(fCands->GetClassifiers()[fIndex]);
+  }
+
+  NeutCand NeutCandView::MakeCand() const{
+    NeutCand cand;
+    if (!this->IsValid()) return cand;
+    cand.fID = this->GetID();
+    cand.fIs3D = this->GetIs3D();
+    cand.fMCPID = this->GetMCPID();
+    cand.fTopMCPID = this->GetTopMCPID();
+    cand.fMCParentTrackID = this->GetMCParentTrackID();
+    cand.fMCParentPID = this->GetMCParentPID();
+    cand.fTotE = this->GetTotalE();
+    cand.fEvtVtx = this->GetEvtVtx();
+    cand.fBegPos = this->GetBegPos();
+    cand.fEndPos = this->GetEndPos();
+    return cand;
+  }
+  
+  const std::vector<NeutCands::BlobBranch<int>>& NeutCands::IntBranches(){
+    static const std::vector<BlobBranch<int>> branches = {
+      {"MasterAnaDev_BlobID", &NeutCands::fID},
+      {"MasterAnaDev_BlobIs3D", &NeutCands::fIs3D},
+      {"MasterAnaDev_BlobMCPID", &NeutCands::fMCPID},
+      {"MasterAnaDev_BlobTopMCPID", &NeutCands::fTopMCPID},
+      {"MasterAnaDev_BlobMCParentTrackID", &NeutCands::fMCParentTrackID},
+      //{"MasterAnaDev_BlobMCParentPID", &NeutCands::fMCParentPID},
+    };
+    return branches;
+  }
+
+  const std::vector<NeutCands::BlobBranch<double>>& NeutCands::DoubleBranches(){
+    static const std::vector<BlobBranch<double>> branches = {
+      {"MasterAnaDev_BlobTotalE", &NeutCands::fTotE},
+      {"MasterAnaDev_BlobBegX", &NeutCands::fBegX},
+      {"MasterAnaDev_BlobBegY", &NeutCands::fBegY},
+      {"MasterAnaDev_BlobBegZ", &NeutCands::fBegZ},
+      {"MasterAnaDev_BlobEndX", &NeutCands::fEndX},
+      {"MasterAnaDev_BlobEndY", &NeutCands::fEndY},
+      {"MasterAnaDev_BlobEndZ", &NeutCands::fEndZ},
+    };
+    return branches;
+  }
+
   NeutCands::NeutCands(){
     this->init();
   }
   
   NeutCands::NeutCands(std::vector<NeutCand> cands){
     this->init();
-    std::map<int, NeutCand> candsMap;
-    double maxE = -1.0;
+    if (cands.size() > 0) this->Clear(cands.at(0).GetEvtVtx());
     for(int i_cand=0;i_cand < (int)cands.size();++i_cand){
-      candsMap[cands.at(i_cand).GetID()]=cands.at(i_cand);
-      if (cands.at(i_cand).GetTotalE() > maxE){
-	fIDmaxE = cands.at(i_cand).GetID();
-	fCandMaxE = cands.at(i_cand);
-	maxE=cands.at(i_cand).GetTotalE();
-      }
-      this->SetCands(candsMap);
+      this->AddCand(cands.at(i_cand));
     }
   }
   
-  NeutCands::NeutCands(std::map<int,intCandData> candsDataInt, std::map<int,doubleCandData> candDataDouble){
+  void NeutCands::init(){
+    fNCands = 0;
+    fIDmaxE = -1;
+    fIndexMaxE = -1;
+    fEvtVtx[0] = 0.0;
+    fEvtVtx[1] = 0.0;
+    fEvtVtx[2] = 0.0;
+    fNRanked = 0;
+    fClassified = false;
+  }
+
+  void NeutCands::Clear(TVector3 vtx){
     this->init();
+    fEvtVtx[0] = vtx.X();
+    fEvtVtx[1] = vtx.Y();
+    fEvtVtx[2] = vtx.Z();
+    fID.clear();
+    fIs3D.clear();
+    fMCPID.clear();
+    fTopMCPID.clear();
+    fMCParentTrackID.clear();
+    fMCParentPID.clear();
+    fTotE.clear();
+    fBegX.clear();
+    fBegY.clear();
+    fBegZ.clear();
+    fEndX.clear();
+    fEndY.clear();
+    fEndZ.clear();
+    fCached.clear();
+    fLength.clear();
+    fVtxDist.clear();
+    fAngleToFP.clear();
   }
-  
-  void NeutCands::init(){
-    fCands = {};
-    fNCands = fCands.size();
+
+  int NeutCands::AddCand(NeutCand cand){
+    TVector3 beg = cand.GetBegPos();
+    TVector3 end = cand.GetEndPos();
+    fID.push_back(cand.GetID());
+    fIs3D.push_back(cand.GetIs3D());
+    fMCPID.push_back(cand.GetMCPID());
+    fTopMCPID.push_back(cand.GetTopMCPID());
+    fMCParentTrackID.push_back(cand.GetMCParentTrackID());
+    fMCParentPID.push_back(cand.GetMCParentPID());
+    fTotE.push_back(cand.GetTotalE());
+    fBegX.push_back(beg.X());
+    fBegY.push_back(beg.Y());
+    fBegZ.push_back(beg.Z());
+    fEndX.push_back(end.X());
+    fEndY.push_back(end.Y());
+    fEndZ.push_back(end.Z());
+    fCached.push_back(0);
+    fLength.push_back(-999.0);
+    fVtxDist.push_back(-999.0);
+    fAngleToFP.push_back(-9999.0);
+    int index = fNCands;
+    ++fNCands;
+    fNRanked = 0;
+    fClassified = false;
+    int first = this->GetIndex(cand.GetID());
+    if (first != index){
+      this->Finalize();
+      return first;
+    }
+    this->UpdateMaxE(index);
+    return index;
+  }
+
+  void NeutCands::CopyRow(int from, int to){
+    fID.Set(to, fID[from]);
+    fIs3D.Set(to, fIs3D[from]);
+    fMCPID.Set(to, fMCPID[from]);
+    fTopMCPID.Set(to, fTopMCPID[from]);
+    fMCParentTrackID.Set(to, fMCParentTrackID[from]);
+    fMCParentPID.Set(to, fMCParentPID[from]);
+    fTotE.Set(to, fTotE[from]);
+    fBegX.Set(to, fBegX[from]);
+    fBegY.Set(to, fBegY[from]);
+    fBegZ.Set(to, fBegZ[from]);
+    fEndX.Set(to, fEndX[from]);
+    fEndY.Set(to, fEndY[from]);
+    fEndZ.Set(to, fEndZ[from]);
+  }
+
+  void NeutCands::MergeDuplicateIDs(){
+    //Blob counts are tens per event, so a linear search over the rows kept so far is cheaper than building a lookup
+    int nKept = 0;
+    for (int index=0; index < fNCands; ++index){
+      int first = 0;
+      while (first < nKept && fID[first] != fID[index]) ++first;
+      if (first != index) this->CopyRow(index,first);
+      if (first == nKept) ++nKept;
+    }
+    if (nKept == fNCands) return;
+    fNCands = nKept;
+    fID.resize(nKept);
+    fIs3D.resize(nKept);
+    fMCPID.resize(nKept);
+    fTopMCPID.resize(nKept);
+    fMCParentTrackID.resize(nKept);
+    fMCParentPID.resize(nKept);
+    fTotE.resize(nKept);
+    fBegX.resize(nKept);
+    fBegY.resize(nKept);
+    fBegZ.resize(nKept);
+    fEndX.resize(nKept);
+    fEndY.resize(nKept);
+    fEndZ.resize(nKept);
+    fLength.resize(nKept);
+    fVtxDist.resize(nKept);
+    fAngleToFP.resize(nKept);
+  }
+
+  void NeutCands::Resize(int nCands){
+    fNCands = nCands;
+    fIDmaxE = -1;
+    fIndexMaxE = -1;
+    fID.assign(nCands,-1);
+    fIs3D.assign(nCands,-999);
+    fMCPID.assign(nCands,-999);
+    fTopMCPID.assign(nCands,-999);
+    fMCParentTrackID.assign(nCands,-999);
+    fMCParentPID.assign(nCands,-999);
+    fTotE.assign(nCands,-999.0);
+    fBegX.assign(nCands,0.0);
+    fBegY.assign(nCands,0.0);
+    fBegZ.assign(nCands,0.0);
+    fEndX.assign(nCands,0.0);
+    fEndY.assign(nCands,0.0);
+    fEndZ.assign(nCands,0.0);
+    fCached.assign(nCands,0);
+    fLength.assign(nCands,-999.0);
+    fVtxDist.assign(nCands,-999.0);
+    fAngleToFP.assign(nCands,-9999.0);
+    fNRanked = 0;
+    fClassified = false;
+  }
+
+  void NeutCands::Finalize(){
+    //Also drops anything derived from the columns, so a store edited with Set after a Finalize can be finalized again
+    this->MergeDuplicateIDs();
     fIDmaxE = -1;
-    fCandMaxE = NeutCand();
+    fIndexMaxE = -1;
+    fCached.assign(fNCands,0);
+    fNRanked = 0;
+    fClassified = false;
+    for (int index=0; index < fNCands; ++index){
+      this->UpdateMaxE(index);
+    }
+  }
+
+  void NeutCands::UpdateMaxE(int index){
+    //Strictly greater keeps the first of any tied candidates as the leading one
+    double maxE = (fIndexMaxE < 0) ? -1.0 : fTotE[fIndexMaxE];
+    if (fTotE[index] > maxE){
+      fIndexMaxE = index;
+      fIDmaxE = fID[index];
+    }
+  }
+
+  double NeutCands::GetAngleToFP(int index) const{
+    if (!(fCached[index] & kAngleCached)){
+      if (GetVtxDist(index) > 0 && GetLength(index) > 0){
+	NeutCandView cand(this,index);
+	fAngleToFP[index] = cand.GetFlightPath().Angle(cand.GetDirection());
+      }
+      else fAngleToFP[index] = -9999.0;
+      fCached[index] |= kAngleCached;
+    }
+    return fAngleToFP[index];
+  }
+
+  const std::vector<unsigned char>& NeutCands::GetClassifiers() const{
+    if (!fClassified){
+      fClassifiers.resize(fNCands);
+      if (fNCands > 0) ClassifyBlobs(fNCands, &fIs3D[0], &fTotE[0], &fBegX[0], &fBegY[0], &fBegZ[0], &fEndX[0], &fEndY[0], &fEndZ[0], fEvtVtx, &fClassifiers[0]);
+      fClassified = true;
+    }
+    return fClassifiers;
+  }
+
+  void NeutCands::GetPassMask(std::bitset<4> required, std::vector<unsigned long long>& words) const{
+    const std::vector<unsigned char>& masks = GetClassifiers();
+    unsigned char req = (unsigned char)required.to_ulong();
+    words.assign((fNCands+63)/64,0);
+    for (int index=0; index < fNCands; ++index){
+      words[index/64] |= (unsigned long long)((masks[index] & req) == req) << (index%64);
+    }
+  }
+
+  int NeutCands::GetNPassing(std::bitset<4> required) const{
+    const std::vector<unsigned char>& masks = GetClassifiers();
+    unsigned char req = (unsigned char)required.to_ulong();
+    int nPassing = 0;
+    for (int index=0; index < fNCands; ++index){
+      nPassing += ((masks[index] & req) == req);
+    }
+    return nPassing;
+  }
+
+  void NeutCands::Classify(const std::vector<const NeutCands*>& events, std::vector<unsigned char>& masks){
+    int nTotal = 0;
+    for (const auto& event: events) nTotal += event->fNCands;
+    masks.resize(nTotal);
+    int offset = 0;
+    for (const auto& event: events){
+      if (event->fNCands > 0) ClassifyBlobs(event->fNCands, &event->fIs3D[0], &event->fTotE[0], &event->fBegX[0], &event->fBegY[0], &event->fBegZ[0], &event->fEndX[0], &event->fEndY[0], &event->fEndZ[0], event->fEvtVtx, &masks[offset]);
+      offset += event->fNCands;
+    }
+  }
+
+  void NeutCands::Rank(int k) const{
+    k = std::min(k, fNCands);
+    if (k <= fNRanked) return;
+    fEnergyOrder.resize(fNCands);
+    for (int index=0; index < fNCands; ++index) fEnergyOrder[index] = index;
+    const double* E = fTotE.data();
+    auto higherE = [E](int a, int b){ return E[a] > E[b] || (E[a] == E[b] && a < b); };
+    if (k == fNCands) std::sort(fEnergyOrder.begin(), fEnergyOrder.end(), higherE);
+    else std::partial_sort(fEnergyOrder.begin(), fEnergyOrder.begin()+k, fEnergyOrder.end(), higherE);
+    fNRanked = k;
+  }
+
+  NeutCands::ranked_range NeutCands::GetTopCands(int k) const{
+    k = std::max(0, std::min(k, fNCands));
+    this->Rank(k);
+    const int* first = fEnergyOrder.empty() ? NULL : &fEnergyOrder[0];
+    return ranked_range(this, first, first ? first+k : NULL);
+  }
+
+  NeutCandView NeutCands::GetRankedCandView(int rank) const{
+    if (rank < 0 || rank >= fNCands) return NeutCandView();
+    this->Rank(rank+1);
+    return NeutCandView(this,fEnergyOrder[rank]);
+  }
+
+  int NeutCands::GetIndex(int ID) const{
+    for (int index=0; index < fNCands; ++index){
+      if (fID[index]==ID) return index;
+    }
+    return -1;
+  }
+
+  std::vector<NeutCand> NeutCands::GetCandidates() const{
+    std::vector<NeutCand> cands;
+    cands.reserve(fNCands);
+    for (const auto& cand: *this){
+      cands.push_back(cand.MakeCand());
+    }
+    return cands;
   }
 
 }
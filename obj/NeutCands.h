@@ -8,19 +8,19 @@
 
 #include "TVector3.h"
 #include "stdlib.h"
+#include <cmath>
 #include <string>
 #include <vector>
-#include <map>
 #include <bitset>
+#include <algorithm>
 
 namespace NeutronCandidates{
-  typedef std::map<std::string, std::vector<const char*>> intBranchMap;
-  typedef std::map<std::string, std::vector<const char*>> doubleBranchMap;
-  typedef std::map<std::string, std::vector<int>> intCandData;
-  typedef std::map<std::string, std::vector<double>> doubleCandData;
-
-  intBranchMap GetBranchIntMap();
-  doubleBranchMap GetBranchDoubleMap();
+  //Branchless form of the four GetClassifier tests over n candidates from one event, laid out as plain arrays so the compiler can vectorize the loop.
+  //Bit i of masks[index] is bit i of the classifier bitset. The angle window is tested on the cosine, so no acos is needed.
+  void ClassifyBlobs(int n, const int* is3D, const double* totE,
+		     const double* begX, const double* begY, const double* begZ,
+		     const double* endX, const double* endY, const double* endZ,
+		     const double* vtx, unsigned char* masks);
 
   class NeutCand{
   private:
@@ -33,19 +33,29 @@ namespace NeutronCandidates{
     int fMCParentTrackID;
     int fMCParentPID;
     double fTotE;
-    double fAngleToFP;
     TVector3 fEvtVtx;
     TVector3 fBegPos;
     TVector3 fEndPos;
+
+    //Derived geometry. Filled on first access and dropped whenever a position changes.
+    enum { kDirectionCached=1, kFlightPathCached=2, kAngleCached=4 };
+    int fCached;
+    double fLength;
+    double fVtxDist;
+    double fAngleToFP;
     TVector3 fDirection;
     TVector3 fFlightPath;
 
     void init();
+    void CacheDirection();
+    void CacheFlightPath();
+    void CacheAngle();
+
+    friend class NeutCandView;
 
   public:
     //CTOR
     NeutCand();
-    NeutCand(NeutronCandidates::intCandData candIntData, NeutronCandidates::doubleCandData candDoubleData, TVector3 vtx);
 
     int GetID(){ return fID; };
     int GetIs3D(){ return fIs3D; };
@@ -54,11 +64,14 @@ namespace NeutronCandidates{
     int GetMCParentTrackID(){ return fMCParentTrackID; };
     int GetMCParentPID(){ return fMCParentPID; };
     double GetTotalE(){ return fTotE; };
-    double GetAngleToFP(){ return fAngleToFP; };
+    double GetAngleToFP(){ if (!(fCached & kAngleCached)) CacheAngle(); return fAngleToFP; };
+    double GetLength(){ if (!(fCached & kDirectionCached)) CacheDirection(); return fLength; };
+    double GetVtxDist(){ if (!(fCached & kFlightPathCached)) CacheFlightPath(); return fVtxDist; };
+    double GetdEdx(){ return (GetLength() > 0.0) ? fTotE/fLength : -1.0; };
     TVector3 GetBegPos(){ return fBegPos; };
     TVector3 GetEndPos(){ return fEndPos; };
-    TVector3 GetFlightPath(){ return fFlightPath; };
-    TVector3 GetDirection(){ return fDirection; };
+    TVector3 GetFlightPath(){ if (!(fCached & kFlightPathCached)) CacheFlightPath(); return fFlightPath; };
+    TVector3 GetDirection(){ if (!(fCached & kDirectionCached)) CacheDirection(); return fDirection; };
     TVector3 GetEvtVtx(){ return fEvtVtx; };
     std::bitset<4> GetClassifier();
 
@@ -69,65 +82,262 @@ namespace NeutronCandidates{
     void SetMCParentTrackID(std::vector<int> ParentID){ fMCParentTrackID=ParentID.at(0); };
     void SetMCParentPID(std::vector<int> ParentPID){ fMCParentPID=ParentPID.at(0); };
     void SetTotalE(std::vector<double> TotE){ fTotE=TotE.at(0); };
-    void SetEvtVtx(TVector3 EvtVtx){ fEvtVtx=EvtVtx; };
-    //Move MULTI-LINE DEFINITIONS TO CPP...???
-    void SetBegPos(std::vector<double> BegPos){
-      fBegPos.SetXYZ(BegPos.at(0),BegPos.at(1),BegPos.at(2));
-      fDirection = fEndPos-fBegPos;
-      fFlightPath = fBegPos-fEvtVtx;
-      if (fFlightPath.Mag() > 0 && fDirection.Mag() > 0){
-	fAngleToFP = fFlightPath.Angle(fDirection);
-      }
-      else {
-	fAngleToFP = -9999.0;
-      }
-    };
-    void SetEndPos(std::vector<double> EndPos){
-      fEndPos.SetXYZ(EndPos.at(0),EndPos.at(1),EndPos.at(2));
-      fDirection = fEndPos-fBegPos;
-      fAngleToFP = fFlightPath.Angle(fDirection);
-      if (fFlightPath.Mag() > 0 && fDirection.Mag() > 0){
-	fAngleToFP = fFlightPath.Angle(fDirection);
-      }
-      else {
-	fAngleToFP = -9999.0;
-      }
-    };
+    void SetEvtVtx(TVector3 EvtVtx){ fEvtVtx=EvtVtx; fCached=0; };
+    void SetBegPos(std::vector<double> BegPos){ fBegPos.SetXYZ(BegPos.at(0),BegPos.at(1),BegPos.at(2)); fCached=0; };
+    void SetEndPos(std::vector<double> EndPos){ fEndPos.SetXYZ(EndPos.at(0),EndPos.at(1),EndPos.at(2)); fCached=0; };
 
     //DTOR
     virtual ~NeutCand() = default;
   };
 
+  class NeutCands;
+
+  //Lightweight handle onto one row of the NeutCands column store. Only valid until the owning NeutCands is refilled.
+  class NeutCandView{
+  private:
+    const NeutCands* fCands;
+    int fIndex;
+
+  public:
+    //CTOR
+    NeutCandView(const NeutCands* cands=NULL, int index=-1): fCands(cands), fIndex(index) {};
+
+    bool IsValid() const { return fCands && fIndex >= 0; };
+    int GetIndex() const { return fIndex; };
+
+    inline int GetID() const;
+    inline int GetIs3D() const;
+    inline int GetMCPID() const;
+    inline int GetTopMCPID() const;
+    inline int GetMCParentTrackID() const;
+    inline int GetMCParentPID() const;
+    inline double GetTotalE() const;
+    inline double GetAngleToFP() const;
+    inline double GetBegZ() const;
+    inline double GetFlightPathZ() const;
+    inline double GetFlightPathMag() const;
+    inline double GetLength() const;
+    inline double GetdEdx() const;
+    inline TVector3 GetBegPos() const;
+    inline TVector3 GetEndPos() const;
+    inline TVector3 GetFlightPath() const;
+    inline TVector3 GetDirection() const;
+    inline TVector3 GetEvtVtx() const;
+    std::bitset<4> GetClassifier() const;
+    NeutCand MakeCand() const;
+  };
+
+  //One candidate quantity for every row of a NeutCands. Normally backed by its own storage, reused from event to event; Borrow points it at someone
+  //else's array (e.g. a memory-mapped skim) instead of copying. The first write to a borrowed column copies it into its own storage.
+  template <typename T> class BlobColumn{
+  private:
+    std::vector<T> fStore;
+    const T* fBorrowed;
+    int fNBorrowed;
+    void Own(){
+      if (!fBorrowed) return;
+      fStore.assign(fBorrowed, fBorrowed+fNBorrowed);
+      fBorrowed = NULL;
+    };
+  public:
+    BlobColumn(): fBorrowed(NULL), fNBorrowed(0) {};
+    const T& operator[](int index) const { return fBorrowed ? fBorrowed[index] : fStore[index]; };
+    const T* data() const { return fBorrowed ? fBorrowed : fStore.data(); };
+    void Set(int index, T value){ Own(); fStore[index] = value; };
+    void Copy(const T* values, int nValues){ Own(); std::copy(values, values+nValues, fStore.begin()); };
+    //values must stay put until the column is next cleared, assigned or written
+    void Borrow(const T* values, int nValues){ fBorrowed = values; fNBorrowed = nValues; };
+    void clear(){ fBorrowed = NULL; fStore.clear(); };
+    void assign(int n, T value){ fBorrowed = NULL; fStore.assign(n, value); };
+    void resize(int n){ Own(); fStore.resize(n); };
+    void push_back(T value){ Own(); fStore.push_back(value); };
+  };
+
+  //Candidates are stored column-wise (one contiguous array per quantity) and the columns are reused from event to event.
+  //Flight paths come straight from the begin position and vertex; lengths, vertex distances and angles are filled per row on first access.
   class NeutCands {
   private:
     int fNCands;
     int fIDmaxE;
-    NeutCand fCandMaxE;
-    std::map<int, NeutCand> fCands;
+    int fIndexMaxE;
+    double fEvtVtx[3];
+
+    BlobColumn<int> fID;
+    BlobColumn<int> fIs3D;
+    BlobColumn<int> fMCPID;
+    BlobColumn<int> fTopMCPID;
+    BlobColumn<int> fMCParentTrackID;
+    BlobColumn<int> fMCParentPID;
+    BlobColumn<double> fTotE;
+    BlobColumn<double> fBegX, fBegY, fBegZ;
+    BlobColumn<double> fEndX, fEndY, fEndZ;
+
+    enum { kLengthCached=1, kVtxDistCached=2, kAngleCached=4 };
+    mutable std::vector<unsigned char> fCached;
+    mutable std::vector<double> fLength;
+    mutable std::vector<double> fVtxDist;
+    mutable std::vector<double> fAngleToFP;
+
+    //Row indices by descending energy (ties keep row order). Only the first fNRanked are guaranteed sorted.
+    mutable int fNRanked;
+    mutable std::vector<int> fEnergyOrder;
+    void Rank(int k) const;
+
+    mutable bool fClassified;
+    mutable std::vector<unsigned char> fClassifiers;
+
+    double GetLength(int index) const{
+      if (!(fCached[index] & kLengthCached)){
+	double dx = fEndX[index]-fBegX[index];
+	double dy = fEndY[index]-fBegY[index];
+	double dz = fEndZ[index]-fBegZ[index];
+	fLength[index] = sqrt(dx*dx+dy*dy+dz*dz);
+	fCached[index] |= kLengthCached;
+      }
+      return fLength[index];
+    };
+    double GetVtxDist(int index) const{
+      if (!(fCached[index] & kVtxDistCached)){
+	double dx = fBegX[index]-fEvtVtx[0];
+	double dy = fBegY[index]-fEvtVtx[1];
+	double dz = fBegZ[index]-fEvtVtx[2];
+	fVtxDist[index] = sqrt(dx*dx+dy*dy+dz*dz);
+	fCached[index] |= kVtxDistCached;
+      }
+      return fVtxDist[index];
+    };
+    double GetAngleToFP(int index) const;
 
     void init();
+    void UpdateMaxE(int index);
+    //Copies every stored column of row from onto row to
+    void CopyRow(int from, int to);
+    //Blob IDs are unique within an event, as the old std::map store made them: a repeated ID overwrites the earlier row (last one wins) and the later row is dropped
+    void MergeDuplicateIDs();
+
+    friend class NeutCandView;
 
   public:
+    //Ties one MasterAnaDev_Blob* branch to the column it fills. The tables themselves are in NeutCands.cpp, so a new blob field is one line there (plus its column).
+    template <typename T> struct BlobBranch{
+      const char* name;
+      BlobColumn<T> NeutCands::* column;
+    };
+    static const std::vector<BlobBranch<int>>& IntBranches();
+    static const std::vector<BlobBranch<double>>& DoubleBranches();
+
     //CTORS
     NeutCands();
     NeutCands(std::vector<NeutCand> cands);
-    NeutCands(std::map<int,intCandData> candsDataInt, std::map<int,doubleCandData> candDataDouble);
+    //Several events' worth of classifier bits, written back to back into masks
+    static void Classify(const std::vector<const NeutCands*>& events, std::vector<unsigned char>& masks);
 
     //DTOR
     virtual ~NeutCands() = default;
+
+    //Empties the columns without giving back their capacity.
+    void Clear(TVector3 vtx=TVector3());
+    int AddCand(NeutCand cand);
+    //Table-driven filling: Resize to the blob count, Set each branch value, then Finalize to pick out the leading candidate.
+    //Editing a finalized store with Set needs another Finalize. Finalize also merges rows sharing a blob ID, so GetNCands() can shrink.
+    void Resize(int nCands);
+    void Set(const BlobBranch<int>& branch, int index, int value){ (this->*branch.column).Set(index,value); };
+    void Set(const BlobBranch<double>& branch, int index, double value){ (this->*branch.column).Set(index,value); };
+    //Bulk version of Set for a whole branch vector read once per entry. Entries past GetNCands() are ignored.
+    template <typename T> void SetColumn(const BlobBranch<T>& branch, const std::vector<T>& values){
+      SetColumn(branch, values.data(), (int)values.size());
+    };
+    template <typename T> void SetColumn(const BlobBranch<T>& branch, const T* values, int nValues){
+      (this->*branch.column).Copy(values, std::min(nValues, fNCands));
+    };
+    //SetColumn without the copy: the column reads straight out of values, which must outlive the store's current event.
+    //Falls back to copying when values is shorter than the store.
+    template <typename T> void BorrowColumn(const BlobBranch<T>& branch, const T* values, int nValues){
+      if (nValues < fNCands) SetColumn(branch, values, nValues);
+      else (this->*branch.column).Borrow(values, fNCands);
+    };
+    template <typename T> const BlobColumn<T>& GetColumn(const BlobBranch<T>& branch) const { return this->*branch.column; };
+    void Finalize();
     
-    void SetCands(std::map<int, NeutCand> inCands){ 
-      fCands=inCands; 
-      fNCands=inCands.size();
-    }
-
-    int GetIDMaxE(){ return fIDmaxE; };
-    int GetNCands(){ return fNCands; };
-    NeutCand GetCandidate(int ID){ 
-      if (fNCands == 0) return NeutCand();
-      else return fCands[ID]; };
-    NeutCand GetMaxCandidate(){ return fCandMaxE; };
-    std::map<int, NeutCand> GetCandidates(){ return fCands; };
+    //Walks the store row by row, handing out NeutCandViews, so range-based loops never copy a candidate
+    class const_iterator{
+    private:
+      const NeutCands* fCands;
+      int fIndex;
+    public:
+      const_iterator(const NeutCands* cands, int index): fCands(cands), fIndex(index) {};
+      NeutCandView operator*() const { return NeutCandView(fCands,fIndex); };
+      const_iterator& operator++(){ ++fIndex; return *this; };
+      bool operator==(const const_iterator& other) const { return fIndex == other.fIndex && fCands == other.fCands; };
+      bool operator!=(const const_iterator& other) const { return !(*this == other); };
+    };
+    const_iterator begin() const { return const_iterator(this,0); };
+    const_iterator end() const { return const_iterator(this,fNCands); };
+
+    //Views onto the k most energetic candidates, leading first. The ordering is built once per refill with a partial sort.
+    class ranked_range{
+    private:
+      const NeutCands* fCands;
+      const int* fFirst;
+      const int* fLast;
+    public:
+      class const_iterator{
+      private:
+	const NeutCands* fCands;
+	const int* fRow;
+      public:
+	const_iterator(const NeutCands* cands, const int* row): fCands(cands), fRow(row) {};
+	NeutCandView operator*() const { return NeutCandView(fCands,*fRow); };
+	const_iterator& operator++(){ ++fRow; return *this; };
+	bool operator==(const const_iterator& other) const { return fRow == other.fRow; };
+	bool operator!=(const const_iterator& other) const { return fRow != other.fRow; };
+      };
+      ranked_range(const NeutCands* cands, const int* first, const int* last): fCands(cands), fFirst(first), fLast(last) {};
+      const_iterator begin() const { return const_iterator(fCands,fFirst); };
+      const_iterator end() const { return const_iterator(fCands,fLast); };
+      int size() const { return fLast-fFirst; };
+      NeutCandView operator[](int rank) const { return NeutCandView(fCands,fFirst[rank]); };
+    };
+    ranked_range GetTopCands(int k) const;
+    //rank 0 is the most energetic candidate; out of range ranks give an invalid view
+    NeutCandView GetRankedCandView(int rank) const;
+    NeutCandView GetSubleadingCandView() const { return GetRankedCandView(1); };
+
+    int GetIDMaxE() const { return fIDmaxE; };
+    int GetNCands() const { return fNCands; };
+    int GetIndex(int ID) const;
+    //Lookup by blob ID that never adds anything. The view is invalid if ID isn't present.
+    NeutCandView FindCand(int ID) const { return NeutCandView(this,GetIndex(ID)); };
+    NeutCand GetCandidate(int ID) const { return FindCand(ID).MakeCand(); };
+    NeutCand GetMaxCandidate() const { return GetMaxCandView().MakeCand(); };
+    //Classifier bits for every candidate, computed in one batch the first time they are asked for after a refill
+    const std::vector<unsigned char>& GetClassifiers() const;
+    //Fills words with one bit per candidate (64 to a word), set when the candidate has every bit of required. The caller owns the buffer, so reusing it across events avoids reallocating.
+    void GetPassMask(std::bitset<4> required, std::vector<unsigned long long>& words) const;
+    int GetNPassing(std::bitset<4> required) const;
+    NeutCandView GetCandView(int index) const { return NeutCandView(this,index); };
+    NeutCandView GetMaxCandView() const { return NeutCandView(this,fIndexMaxE); };
+    //Materializes a copy of every candidate; prefer iterating the store directly
+    std::vector<NeutCand> GetCandidates() const;
   };
+
+  int NeutCandView::GetID() const { return fCands->fID[fIndex]; }
+  int NeutCandView::GetIs3D() const { return fCands->fIs3D[fIndex]; }
+  int NeutCandView::GetMCPID() const { return fCands->fMCPID[fIndex]; }
+  int NeutCandView::GetTopMCPID() const { return fCands->fTopMCPID[fIndex]; }
+  int NeutCandView::GetMCParentTrackID() const { return fCands->fMCParentTrackID[fIndex]; }
+  int NeutCandView::GetMCParentPID() const { return fCands->fMCParentPID[fIndex]; }
+  double NeutCandView::GetTotalE() const { return fCands->fTotE[fIndex]; }
+  double NeutCandView::GetAngleToFP() const { return fCands->GetAngleToFP(fIndex); }
+  double NeutCandView::GetBegZ() const { return fCands->fBegZ[fIndex]; }
+  double NeutCandView::GetFlightPathZ() const { return fCands->fBegZ[fIndex]-fCands->fEvtVtx[2]; }
+  double NeutCandView::GetFlightPathMag() const { return fCands->GetVtxDist(fIndex); }
+  double NeutCandView::GetLength() const { return fCands->GetLength(fIndex); }
+  double NeutCandView::GetdEdx() const { return (GetLength() > 0.0) ? GetTotalE()/GetLength() : -1.0; }
+  TVector3 NeutCandView::GetBegPos() const { return TVector3(fCands->fBegX[fIndex],fCands->fBegY[fIndex],fCands->fBegZ[fIndex]); }
+  TVector3 NeutCandView::GetEndPos() const { return TVector3(fCands->fEndX[fIndex],fCands->fEndY[fIndex],fCands->fEndZ[fIndex]); }
+  TVector3 NeutCandView::GetFlightPath() const { return GetBegPos()-GetEvtVtx(); }
+  TVector3 NeutCandView::GetDirection() const { return GetEndPos()-GetBegPos(); }
+  TVector3 NeutCandView::GetEvtVtx() const { return TVector3(fCands->fEvtVtx[0],fCands->fEvtVtx[1],fCands->fEvtVtx[2]); }
 }
 #endif
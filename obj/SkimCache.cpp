@@ -0,0 +1,173 @@
+//File: SkimCache.cpp
+//Info: Writer and memory-mapped reader for the EventLoop skim cache. See SkimCache.h for the layout.
+//
+//Author: David Last dlast@sas.upenn.edu/lastd44@gmail.com
+
+#include "SkimCache.h"
+#include <iostream>
+#include <cstring>
+#include <cstddef>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace{
+  const char skimMagic[8] = {'N','P','S','K','I','M','\0','\0'};
+  //2 added the muon kinematics and total recoil
+  const int skimVersion = 2;
+
+  std::size_t Padded(std::size_t bytes){ return (bytes + 7) & ~((std::size_t)7); }
+
+  //Branch names in table order, each as an int length then the characters, so a reader can tell if the tables have changed
+  std::vector<std::string> BranchNames(){
+    std::vector<std::string> names;
+    for (const auto& branch: NeutronCandidates::NeutCands::IntBranches()) names.push_back(branch.name);
+    for (const auto& branch: NeutronCandidates::NeutCands::DoubleBranches()) names.push_back(branch.name);
+    return names;
+  }
+}
+
+SkimWriter::SkimWriter(std::string path): fOut(path.c_str(), std::ios::binary | std::ios::trunc), fPos(0) {
+  if (!fOut.is_open()){
+    std::cout << "Couldn't open skim cache " << path << " for writing." << std::endl;
+    return;
+  }
+  SkimHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, skimMagic, sizeof(header.magic));
+  header.version = skimVersion;
+  header.nIntBranches = NeutronCandidates::NeutCands::IntBranches().size();
+  header.nDoubleBranches = NeutronCandidates::NeutCands::DoubleBranches().size();
+  header.eventSize = sizeof(SkimEvent);
+  WriteBytes(&header, sizeof(header));
+  for (const auto& name: BranchNames()){
+    int length = name.size();
+    WriteBytes(&length, sizeof(length));
+    WriteBytes(name.c_str(), length);
+  }
+  Pad();
+}
+
+SkimWriter::~SkimWriter(){
+  Close();
+}
+
+void SkimWriter::WriteBytes(const void* data, std::size_t bytes){
+  fOut.write(static_cast<const char*>(data), bytes);
+  fPos += bytes;
+}
+
+void SkimWriter::Pad(){
+  static const char zeros[8] = {0,0,0,0,0,0,0,0};
+  std::size_t extra = Padded(fPos) - fPos;
+  if (extra) WriteBytes(zeros, extra);
+}
+
+void SkimWriter::Write(const SkimEvent& evt, const int* FSPartPDG, const double* FSPartE, const double* FSPartPx, const double* FSPartPy, const double* FSPartPz, const NeutronCandidates::NeutCands& cands){
+  if (!IsOpen()) return;
+  fOffsets.push_back(fPos);
+  WriteBytes(&evt, sizeof(evt));
+  WriteBytes(FSPartPDG, evt.nFSPart*sizeof(int));
+  Pad();
+  WriteBytes(FSPartE, evt.nFSPart*sizeof(double));
+  WriteBytes(FSPartPx, evt.nFSPart*sizeof(double));
+  WriteBytes(FSPartPy, evt.nFSPart*sizeof(double));
+  WriteBytes(FSPartPz, evt.nFSPart*sizeof(double));
+  for (const auto& branch: NeutronCandidates::NeutCands::IntBranches()){
+    WriteBytes(cands.GetColumn(branch).data(), evt.nBlobs*sizeof(int));
+    Pad();
+  }
+  for (const auto& branch: NeutronCandidates::NeutCands::DoubleBranches()){
+    WriteBytes(cands.GetColumn(branch).data(), evt.nBlobs*sizeof(double));
+  }
+}
+
+void SkimWriter::Close(){
+  if (!IsOpen()) return;
+  long long indexOffset = fPos;
+  if (!fOffsets.empty()) WriteBytes(fOffsets.data(), fOffsets.size()*sizeof(long long));
+  long long nEvents = fOffsets.size();
+  fOut.seekp(offsetof(SkimHeader, nEvents));
+  fOut.write(reinterpret_cast<const char*>(&nEvents), sizeof(nEvents));
+  fOut.write(reinterpret_cast<const char*>(&indexOffset), sizeof(indexOffset));
+  fOut.close();
+}
+
+SkimReader::SkimReader(std::string path): fData(NULL), fSize(0), fHeader(NULL), fIndex(NULL) {
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0){
+    std::cout << "Couldn't open skim cache " << path << std::endl;
+    return;
+  }
+  struct stat info;
+  if (fstat(fd, &info) == 0 && info.st_size >= (off_t)sizeof(SkimHeader)){
+    void* data = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data != MAP_FAILED){
+      fData = static_cast<char*>(data);
+      fSize = info.st_size;
+    }
+  }
+  close(fd);
+  if (!fData){
+    std::cout << "Couldn't map skim cache " << path << std::endl;
+    return;
+  }
+
+  const SkimHeader* header = reinterpret_cast<const SkimHeader*>(fData);
+  if (memcmp(header->magic, skimMagic, sizeof(skimMagic)) != 0 || header->version != skimVersion || header->eventSize != (int)sizeof(SkimEvent)){
+    std::cout << "Skim cache " << path << " is not a version " << skimVersion << " skim. Rewrite it." << std::endl;
+    return;
+  }
+  if (header->nIntBranches != (int)NeutronCandidates::NeutCands::IntBranches().size() || header->nDoubleBranches != (int)NeutronCandidates::NeutCands::DoubleBranches().size()){
+    std::cout << "Skim cache " << path << " was written with different blob branches. Rewrite it." << std::endl;
+    return;
+  }
+  std::size_t pos = sizeof(SkimHeader);
+  for (const auto& name: BranchNames()){
+    int length = 0;
+    memcpy(&length, fData+pos, sizeof(length));
+    pos += sizeof(length);
+    if (std::string(fData+pos, length) != name){
+      std::cout << "Skim cache " << path << " was written with different blob branches. Rewrite it." << std::endl;
+      return;
+    }
+    pos += length;
+  }
+  if (header->indexOffset + header->nEvents*(long long)sizeof(long long) > (long long)fSize){
+    std::cout << "Skim cache " << path << " is truncated." << std::endl;
+    return;
+  }
+  fIndex = reinterpret_cast<const long long*>(fData + header->indexOffset);
+  fHeader = header;
+}
+
+SkimReader::~SkimReader(){
+  if (fData) munmap(fData, fSize);
+}
+
+const int* SkimReader::GetFSPartPDG(long long entry) const{
+  return reinterpret_cast<const int*>(GetRecord(entry) + sizeof(SkimEvent));
+}
+
+const double* SkimReader::GetFSPartArray(long long entry, int which) const{
+  int nFSPart = GetEvent(entry).nFSPart;
+  const char* start = GetRecord(entry) + sizeof(SkimEvent) + Padded(nFSPart*sizeof(int));
+  return reinterpret_cast<const double*>(start) + which*nFSPart;
+}
+
+void SkimReader::FillNeutCands(long long entry, NeutronCandidates::NeutCands& cands) const{
+  const SkimEvent& evt = GetEvent(entry);
+  cands.Clear(TVector3(evt.vtx[0],evt.vtx[1],evt.vtx[2]));
+  cands.Resize(evt.nBlobs);
+  const char* pos = GetRecord(entry) + sizeof(SkimEvent) + Padded(evt.nFSPart*sizeof(int)) + 4*evt.nFSPart*sizeof(double);
+  for (const auto& branch: NeutronCandidates::NeutCands::IntBranches()){
+    cands.BorrowColumn(branch, reinterpret_cast<const int*>(pos), evt.nBlobs);
+    pos += Padded(evt.nBlobs*sizeof(int));
+  }
+  for (const auto& branch: NeutronCandidates::NeutCands::DoubleBranches()){
+    cands.BorrowColumn(branch, reinterpret_cast<const double*>(pos), evt.nBlobs);
+    pos += evt.nBlobs*sizeof(double);
+  }
+  cands.Finalize();
+}
@@ -0,0 +1,104 @@
+//File: SkimCache.h
+//Info: Flat binary cache of the per-entry quantities EventLoop actually uses (vertex, muon, recoil, EM blob summary, truth FS particles, blob candidates).
+//      SkimWriter streams it out during a normal run; SkimReader memory-maps it so later runs read straight out of the page cache instead of the chain.
+//
+//      Layout: SkimHeader, the blob branch names, then one record per entry, then an offset index (one long long per entry).
+//      Each record is a SkimEvent followed by the FS particle arrays (PDG, E, Px, Py, Pz) and one array per NeutCands blob branch, every array padded to 8 bytes.
+//
+//Author: David Last dlast@sas.upenn.edu/lastd44@gmail.com
+
+#ifndef SKIMCACHE_H
+#define SKIMCACHE_H
+
+#include "NeutCands.h"
+#include <string>
+#include <vector>
+#include <fstream>
+
+//Unshifted values of the CVUniverse getters the cuts and fills rely on. Energies are in the units of the getters that produce them.
+//The muon kinematics and the total recoil are the CV values; shifted universes add their shifts on top of them.
+struct SkimEvent{
+  double vtx[4];
+  double muon4V[4];
+  double Pmu;
+  double Thetamu;
+  double Emu;
+  double recoilE;
+  double calRecoilE;
+  double DANRecoilEGeV;
+  double emNBlobs;
+  double emTotalE;
+  double emNHits;
+  int nTracks;
+  int nImprovedMichel;
+  int hasInteractionVertex;
+  int nDeadDiscriminators;
+  int nuHelicity;
+  int mcCurrent;
+  int mcIncoming;
+  int mcIntType;
+  int nFSPart;
+  int nBlobs;
+};
+
+struct SkimHeader{
+  char magic[8];
+  int version;
+  int nIntBranches;
+  int nDoubleBranches;
+  int eventSize;
+  long long nEvents;
+  long long indexOffset;
+};
+
+class SkimWriter{
+ private:
+  std::ofstream fOut;
+  std::vector<long long> fOffsets;
+  long long fPos;
+
+  void WriteBytes(const void* data, std::size_t bytes);
+  void Pad();
+
+ public:
+  //CTOR
+  SkimWriter(std::string path);
+
+  //DTOR
+  ~SkimWriter();
+
+  bool IsOpen() const { return fOut.is_open(); };
+  void Write(const SkimEvent& evt, const int* FSPartPDG, const double* FSPartE, const double* FSPartPx, const double* FSPartPy, const double* FSPartPz, const NeutronCandidates::NeutCands& cands);
+  //Writes the index and patches the header. Also done by the DTOR.
+  void Close();
+};
+
+class SkimReader{
+ private:
+  char* fData;
+  std::size_t fSize;
+  const SkimHeader* fHeader;
+  const long long* fIndex;
+
+  const char* GetRecord(long long entry) const { return fData + fIndex[entry]; };
+
+ public:
+  //CTOR
+  SkimReader(std::string path);
+
+  //DTOR
+  ~SkimReader();
+
+  bool IsOpen() const { return fHeader != NULL; };
+  long long GetNEvents() const { return fHeader ? fHeader->nEvents : 0; };
+
+  //Everything below points straight into the mapped file
+  const SkimEvent& GetEvent(long long entry) const { return *reinterpret_cast<const SkimEvent*>(GetRecord(entry)); };
+  const int* GetFSPartPDG(long long entry) const;
+  //which: 0=E, 1=Px, 2=Py, 3=Pz
+  const double* GetFSPartArray(long long entry, int which) const;
+  //The blob branch columns of cands borrow the record's arrays, so cands is only good while this reader is open
+  void FillNeutCands(long long entry, NeutronCandidates::NeutCands& cands) const;
+};
+
+#endif
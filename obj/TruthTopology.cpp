@@ -0,0 +1,71 @@
+//File: TruthTopology.cpp
+//Info: See TruthTopology.h.
+//
+//Author: David Last dlast@sas.upenn.edu/lastd44@gmail.com
+
+#include "TruthTopology.h"
+#include <algorithm>
+
+namespace{
+  struct PDGEntry{
+    int PDG;
+    TruthTopology::Category category;
+  };
+  bool operator<(const PDGEntry& entry, int PDG){ return entry.PDG < PDG; }
+
+  //Sorted by PDG code. Photons, protons and neutrons are entered as the energetic category and moved to the soft one below threshold.
+  const PDGEntry PDGTable[] = {
+    {-323, TruthTopology::kMeson}, {-321, TruthTopology::kMeson}, {-211, TruthTopology::kMeson}, {-13, TruthTopology::kMuon},
+    {13, TruthTopology::kMuon}, {22, TruthTopology::kPhoton}, {111, TruthTopology::kMeson}, {130, TruthTopology::kMeson},
+    {211, TruthTopology::kMeson}, {310, TruthTopology::kMeson}, {311, TruthTopology::kMeson}, {313, TruthTopology::kMeson},
+    {321, TruthTopology::kMeson}, {323, TruthTopology::kMeson}, {411, TruthTopology::kHeavyBaryon}, {421, TruthTopology::kHeavyBaryon},
+    {2112, TruthTopology::kNeutron}, {2212, TruthTopology::kProton}, {3112, TruthTopology::kHeavyBaryon}, {3122, TruthTopology::kHeavyBaryon},
+    {3212, TruthTopology::kHeavyBaryon}, {3222, TruthTopology::kHeavyBaryon}, {4112, TruthTopology::kHeavyBaryon}, {4122, TruthTopology::kHeavyBaryon},
+    {4222, TruthTopology::kHeavyBaryon}
+  };
+  const PDGEntry* PDGTableEnd = PDGTable + sizeof(PDGTable)/sizeof(PDGTable[0]);
+
+  //Total energy thresholds [MeV]
+  const double photonE = 10.0;
+  const double protonE = 1058.272;
+  const double neutronE = 949.57;
+}
+
+TruthTopology::TruthTopology(): fCurrent(-999), fIncoming(-999) {
+  std::fill(fCounts, fCounts+kNCategories, 0);
+}
+
+TruthTopology::Category TruthTopology::GetCategory(int PDG, double E){
+  const PDGEntry* entry = std::lower_bound(PDGTable, PDGTableEnd, PDG);
+  if (entry == PDGTableEnd || entry->PDG != PDG) return kOther;
+  switch (entry->category){
+  case kPhoton: return (E > photonE) ? kPhoton : kSoftPhoton;
+  case kProton: return (E > protonE) ? kProton : kSoftProton;
+  case kNeutron: return (E > neutronE) ? kNeutron : kSoftNeutron;
+  default: return entry->category;
+  }
+}
+
+void TruthTopology::Classify(int current, int incoming, int nFSPart, const int* PDG, const double* E){
+  fCurrent = current;
+  fIncoming = incoming;
+  std::fill(fCounts, fCounts+kNCategories, 0);
+  for (int index=0; index < nFSPart; ++index) ++fCounts[GetCategory(PDG[index], E[index])];
+}
+
+bool TruthTopology::IsSignal(Signal signal) const{
+  bool CCQELike = fCurrent == 1 && fIncoming == -14 &&
+    fCounts[kMuon] == 1 &&
+    fCounts[kMeson] == 0 &&
+    fCounts[kHeavyBaryon] == 0 &&
+    fCounts[kPhoton] == 0 &&
+    fCounts[kProton] == 0;
+  if (!CCQELike) return false;
+  switch (signal){
+  case kCCQELikeAntiNuNeutron: return fCounts[kNeutron] > 0;
+  case kCCQELikeAntiNu: return true;
+  case kCCQELikeAntiNuNoNeutron: return fCounts[kNeutron] == 0;
+  case kCCQELikeAntiNuAnyNeutron: return fCounts[kNeutron]+fCounts[kSoftNeutron] > 0;
+  default: return false;
+  }
+}
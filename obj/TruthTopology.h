@@ -0,0 +1,40 @@
+//File: TruthTopology.h
+//Info: One-pass classification of the true final state. Each FS particle is binned through a small sorted PDG table (plus the kinetic thresholds the signal
+//      definitions use), and the per-category counts answer every signal definition without walking the particles again.
+//
+//Author: David Last dlast@sas.upenn.edu/lastd44@gmail.com
+
+#ifndef TRUTHTOPOLOGY_H
+#define TRUTHTOPOLOGY_H
+
+class TruthTopology{
+ public:
+  //Photons, protons and neutrons are split at the energy thresholds of the signal definition; "Soft" ones are at or below it
+  enum Category{ kMuon, kMeson, kHeavyBaryon, kPhoton, kSoftPhoton, kProton, kSoftProton, kNeutron, kSoftNeutron, kOther, kNCategories };
+
+  enum Signal{
+    kCCQELikeAntiNuNeutron,    //The analysis signal: CC anti-numu, one muon, no mesons/heavy baryons/photons/protons above threshold, at least one neutron above threshold
+    kCCQELikeAntiNu,           //Same without any neutron requirement
+    kCCQELikeAntiNuNoNeutron,  //Same with no neutron above threshold
+    kCCQELikeAntiNuAnyNeutron, //Same with at least one neutron of any energy
+    kNSignals
+  };
+
+ private:
+  int fCurrent;
+  int fIncoming;
+  int fCounts[kNCategories];
+
+ public:
+  //CTOR
+  TruthTopology();
+
+  void Classify(int current, int incoming, int nFSPart, const int* PDG, const double* E);
+
+  static Category GetCategory(int PDG, double E);
+
+  int GetCount(Category category) const { return fCounts[category]; };
+  bool IsSignal(Signal signal) const;
+};
+
+#endif
@@ -9,86 +9,334 @@
 #include "PlotUtils/PhysicsVariables.h"
 #include "PlotUtils/MinervaUniverse.h"
 #include "obj/NeutCands.h"
+#include "obj/EventArena.h"
+#include "obj/SkimCache.h"
+#include "syst/SharedEntry.h"
+#include "obj/BranchHandle.h"
+#include "obj/EventKinematics.h"
 #include "TVector3.h"
+#include "TLorentzVector.h"
+#include <cstring>
+#include <limits>
 
-class CVUniverse: public PlotUtils::MinervaUniverse {
+//The PlotUtils muon and recoil functions sit one level below CVUniverse, so CVUniverse can override them to serve the CV values from a skim.
+//Shifted universes call CVUniverse's versions and add their shifts on top.
+class CVUniverseBase: public PlotUtils::MinervaUniverse {
  public:
   //CTOR
- CVUniverse(typename PlotUtils::MinervaUniverse::config_t chw, const double nsigma=0): PlotUtils::MinervaUniverse(chw, nsigma) {}
+ CVUniverseBase(typename PlotUtils::MinervaUniverse::config_t chw, const double nsigma=0): PlotUtils::MinervaUniverse(chw, nsigma) {}
+
+  //DTOR
+  virtual ~CVUniverseBase() = default;
+
+  #include "PlotUtils/SystCalcs/MuonFunctions.h"
+  #include "PlotUtils/SystCalcs/RecoilEnergyFunctions.h"
+};
+
+class CVUniverse: public CVUniverseBase {
+ public:
+  //CTOR
+ CVUniverse(typename PlotUtils::MinervaUniverse::config_t chw, const double nsigma=0): CVUniverseBase(chw, nsigma), fSkim(NULL), fSkimEvt(NULL), fEntry(-1), fShared(NULL), fMemoValid(0), fMemoHits(0), fMemoMisses(0), fCurrentCands(NULL), fNNeutCands(0), fWeightIndex(-1), fBandFactor(-1) {
+    TTree* tree = chw ? chw->GetTree() : NULL;
+    for (int id=0; id < kNBranches; ++id) fBranches.push_back(BranchHandle(tree, GetBranchName((BranchID)id), IsOptionalBranch(GetBranchName((BranchID)id))));
+    for (const auto& branch: NeutronCandidates::NeutCands::IntBranches()) fIntBlobBranches.push_back(BranchHandle(tree, branch.name, IsOptionalBranch(branch.name)));
+    for (const auto& branch: NeutronCandidates::NeutCands::DoubleBranches()) fDoubleBlobBranches.push_back(BranchHandle(tree, branch.name, IsOptionalBranch(branch.name)));
+  }
 
   //DTOR
   virtual ~CVUniverse() = default;
 
-  //Shared (pre-defined, common, etc.) systematics components
+  //Moving to a new entry releases every temporary drawn from the arena in one go and forgets the memoized quantities
+  virtual void SetEntry(Long64_t entry){
+    fArena.Reset();
+    fMemoValid = 0;
+    Shared().SetEntry(entry);
+    PlotUtils::MinervaUniverse::SetEntry(entry);
+    fEntry = entry;
+    fSkimEvt = (fSkim && entry < fSkim->GetNEvents()) ? &fSkim->GetEvent(entry) : NULL;
+  };
+
+  //Points this universe at a store of unshifted per-entry values shared with the other universes on the chain. NULL goes back to a private one.
+  void SetSharedEntry(SharedEntry* shared){ fShared = shared; };
+  const SharedEntry& GetSharedEntry() const { return Shared(); };
+
+  //Entry-scoped memo for the quantities a universe may shift: each slot is computed at most once per entry in this universe
+  enum MemoSlot{ kMemoMuon4V, kMemoEmu, kMemoPmu, kMemoThetamu, kMemoEnuCCQE, kMemoQ2QE, kMemoRecoil, kNMemoSlots };
+
+  unsigned long long GetMemoHits() const { return fMemoHits; };
+  unsigned long long GetMemoMisses() const { return fMemoMisses; };
+
+  //Memoized views of the PlotUtils muon getters. They call the virtual getters, so shifted universes still get their own shifted values.
+  TLorentzVector GetMuon4VMemo() const {
+    if (!IsMemoized(kMemoMuon4V)){
+      fMemoMuon4V = GetMuon4V();
+      SetMemoized(kMemoMuon4V);
+    }
+    return fMemoMuon4V;
+  };
+  double GetEmuMemo() const { return Memo(kMemoEmu, [this]{ return GetEmu(); }); };
+  double GetPmuMemo() const { return Memo(kMemoPmu, [this]{ return GetPmu(); }); };
+  double GetThetamuMemo() const { return Memo(kMemoThetamu, [this]{ return GetThetamu(); }); };
+
+  //With a skim attached the getters below read their unshifted values from it instead of the chain. Pass NULL to go back to the chain.
+  void SetSkim(const SkimReader* skim){
+    fSkim = skim;
+    fSkimEvt = NULL;
+  };
+
+  //Copies the current entry into the skim. Call after UpdateNeutCands so the stored candidates are this entry's.
+  void WriteSkimEntry(SkimWriter& writer) const{
+    SkimEvent evt;
+    memset(&evt, 0, sizeof(evt));
+    ArenaSpan<double> vtx = CVUniverse::GetVtx();
+    std::copy(vtx.begin(), vtx.end(), evt.vtx);
+    TLorentzVector muon4V = CVUniverse::GetMuon4V();
+    evt.muon4V[0] = muon4V.X();
+    evt.muon4V[1] = muon4V.Y();
+    evt.muon4V[2] = muon4V.Z();
+    evt.muon4V[3] = muon4V.E();
+    evt.Pmu = CVUniverse::GetPmu();
+    evt.Thetamu = CVUniverse::GetThetamu();
+    evt.Emu = CVUniverse::GetEmu();
+    evt.recoilE = CVUniverse::GetRecoilEnergy();
+    evt.calRecoilE = CVUniverse::GetCalRecoilEnergy();
+    evt.DANRecoilEGeV = CVUniverse::GetDANRecoilEnergyGeV();
+    EMBlobSummary EMBlobInfo = CVUniverse::GetEMNBlobsTotalEnergyTotalNHits();
+    evt.emNBlobs = EMBlobInfo.nBlobs;
+    evt.emTotalE = EMBlobInfo.totalE;
+    evt.emNHits = EMBlobInfo.nHits;
+    evt.nTracks = CVUniverse::GetNTracks();
+    evt.nImprovedMichel = CVUniverse::GetNImprovedMichel();
+    evt.hasInteractionVertex = CVUniverse::GetHasInteractionVertex();
+    evt.nDeadDiscriminators = CVUniverse::GetNDeadDiscriminatorsUpstreamMuon();
+    evt.nuHelicity = CVUniverse::GetNuHelicity();
+    evt.mcCurrent = CVUniverse::GetMCCurrent();
+    evt.mcIncoming = CVUniverse::GetMCIncoming();
+    evt.mcIntType = CVUniverse::GetInteractionType();
+    evt.nFSPart = CVUniverse::GetNFSPart();
+    evt.nBlobs = Cands().GetNCands();
+    ArenaSpan<int> PDG = CVUniverse::GetFSPartPDG();
+    ArenaSpan<double> E = CVUniverse::GetFSPartE();
+    ArenaSpan<double> Px = CVUniverse::GetFSPartPx();
+    ArenaSpan<double> Py = CVUniverse::GetFSPartPy();
+    ArenaSpan<double> Pz = CVUniverse::GetFSPartPz();
+    writer.Write(evt, PDG.data(), E.data(), Px.data(), Py.data(), Pz.data(), Cands());
+  };
+
+  EventArena& GetArena() const { return fArena; };
+
+  //Position of this universe's weight in a WeightBank
+  void SetWeightIndex(int index){ fWeightIndex = index; };
+  int GetWeightIndex() const { return fWeightIndex; };
+
+  //The event weight is a product of these factors, each from the MAT weight functions (WeightFunctions.h)
+  enum WeightFactor{ kFluxFactor, kGenieFactor, kRPAFactor, k2p2hFactor, kMinosEffFactor, kNWeightFactors };
+  double GetWeightFactor(int factor) const {
+    switch (factor){
+    case kFluxFactor: return GetFluxAndCVWeight();
+    case kGenieFactor: return GetGenieWeight();
+    case kRPAFactor: return GetRPAWeight();
+    case k2p2hFactor: return GetLowRecoil2p2hWeight();
+    case kMinosEffFactor: return GetMinosEfficiencyWeight();
+    default: return 1.0;
+    }
+  };
+  virtual double GetWeight() const {
+    double weight = 1.0;
+    for (int factor=0; factor < kNWeightFactors; ++factor) weight *= GetWeightFactor(factor);
+    return weight;
+  };
+
+  //For universes of a band that shifts only one factor (e.g. the flux or GENIE bands), so the band's other factors are computed once
+  void SetBandFactor(int factor){ fBandFactor = factor; };
+  int GetBandFactor() const { return fBandFactor; };
+
+  //Weights of n universes of one band (this one among them) for the current entry, written to weights[0..n).
+  //With a band factor set, the factors the band does not shift come from this universe alone and only the shifted one is asked of each universe.
+  virtual void GetBandWeights(const CVUniverse* const* universes, int n, double* weights) const {
+    if (fBandFactor < 0){
+      for (int index=0; index < n; ++index) weights[index] = universes[index]->GetWeight();
+      return;
+    }
+    double unshifted = 1.0;
+    for (int factor=0; factor < kNWeightFactors; ++factor){
+      if (factor != fBandFactor) unshifted *= GetWeightFactor(factor);
+    }
+    for (int index=0; index < n; ++index) weights[index] = unshifted*universes[index]->GetWeightFactor(fBandFactor);
+  };
+
+  //Branches the getters read, each through a BranchHandle resolved once rather than a name looked up on every call
+  enum BranchID{
+    kBranchMultiplicity, kBranchNNeutBlobs, kBranchNEMBlobs, kBranchEMBlobStartZ, kBranchEMBlobNHits,
+    kBranchEMBlobEnergy, kBranchHasInteractionVertex, kBranchIntType, kBranchMCIncoming, kBranchMCCurrent,
+    kBranchVtx, kBranchNFSPart, kBranchFSPartPDG, kBranchFSPartE, kBranchFSPartPx, kBranchFSPartPy,
+    kBranchFSPartPz, kBranchNImprovedMichel, kBranchNDeadDiscriminators, kBranchIsMinosMatchTrack,
+    kBranchIsMinosMatchTrackOLD, kBranchIsMinosMatchStub, kBranchIsMinosMatchStubOLD, kBranchNuHelicity,
+    kBranchRecoilSummedE, kBranchRecoilVtx100mm, kBranchRecoilNonVtx100mm, kNBranches
+  };
+  static const char* GetBranchName(BranchID id){
+    static const char* const names[kNBranches] = {
+      "multiplicity",
+      "MasterAnaDev_BlobIs3D_sz",
+      "nonvtx_iso_blobs_start_position_z_in_prong_sz",
+      "nonvtx_iso_blobs_start_position_z_in_prong",
+      "nonvtx_iso_blobs_n_hits_in_prong",
+      "nonvtx_iso_blobs_energy_in_prong",
+      "has_interaction_vertex",
+      "mc_intType",
+      "mc_incoming",
+      "mc_current",
+      "vtx",
+      "mc_nFSPart",
+      "mc_FSPartPDG",
+      "mc_FSPartE",
+      "mc_FSPartPx",
+      "mc_FSPartPy",
+      "mc_FSPartPz",
+      "improved_michel_vertex_type_sz",
+      "phys_n_dead_discr_pair_upstream_prim_track_proj",
+      "isMinosMatchTrack",
+      "muon_is_minos_match_track",
+      "isMinosMatchStub",
+      "muon_is_minos_match_stub",
+      "MasterAnaDev_nuHelicity",
+      "recoil_summed_energy",
+      "recoil_energy_nonmuon_vtx100mm",
+      "recoil_energy_nonmuon_nonvtx100mm"
+    };
+    return names[id];
+  };
+
+  //Branches allowed to be missing, and read as 0 when they are: truth information, which data doesn't have, and the MINOS match flags, whose
+  //names changed between tuple versions. A missing branch of any other name is an error.
+  static bool IsOptionalBranch(const std::string& name){
+    if (name.compare(0, 3, "mc_") == 0) return true;
+    if (name.find("_BlobMC") != std::string::npos || name.find("_BlobTopMC") != std::string::npos) return true;
+    return (name.find("minos_match") != std::string::npos || name.find("MinosMatch") != std::string::npos);
+  };
+
+  double GetBranchValue(BranchID id, int index=0) const { return fBranches[id].GetValue(fEntry, index); };
+  int GetBranchInt(BranchID id, int index=0) const { return fBranches[id].GetInt(fEntry, index); };
+  int GetBranchLen(BranchID id) const { return fBranches[id].GetLen(fEntry); };
+  //n values of an array branch with one load of the branch; anything past the leaf's length reads as 0
+  template <typename T> void GetBranchArray(BranchID id, T* out, int n) const {
+    int nRead = fBranches[id].GetArray(fEntry, out, n);
+    std::fill(out+nRead, out+n, T(0));
+  };
+
+  //Appends the names of the branches this universe's getters have read so far, for recording a branch whitelist
+  void AddUsedBranches(std::vector<std::string>& names) const {
+    for (const auto& handles: {&fBranches, &fIntBlobBranches, &fDoubleBlobBranches}){
+      for (const auto& handle: *handles){
+	if (handle.IsUsed()) names.push_back(handle.GetName());
+      }
+    }
+  };
+
+  //Whole-branch reads into arena storage, so no heap allocation for short per-entry vectors of known size
+  ArenaVector<double> GetArenaVec(BranchID id, int size) const {
+    ArenaVector<double> vec(size, 0.0, ArenaAllocator<double>(&fArena));
+    if (size > 0) GetBranchArray(id, vec.data(), size);
+    return vec;
+  };
+  ArenaVector<int> GetArenaVecInt(BranchID id, int size) const {
+    ArenaVector<int> vec(size, 0, ArenaAllocator<int>(&fArena));
+    if (size > 0) GetBranchArray(id, vec.data(), size);
+    return vec;
+  };
+
+  //Shared (pre-defined, common, etc.) systematics components. The muon and recoil ones are in CVUniverseBase.
   #include "PlotUtils/SystCalcs/WeightFunctions.h"
-  #include "PlotUtils/SystCalcs/MuonFunctions.h"
   #include "PlotUtils/SystCalcs/TruthFunctions.h"
-  #include "PlotUtils/SystCalcs/RecoilEnergyFunctions.h"
+
+  //CV muon kinematics and total recoil, from the skim when one is attached. Shifted universes that override these still call them for the CV value.
+  virtual TLorentzVector GetMuon4V() const {
+    if (fSkimEvt) return TLorentzVector(fSkimEvt->muon4V[0],fSkimEvt->muon4V[1],fSkimEvt->muon4V[2],fSkimEvt->muon4V[3]);
+    return CVUniverseBase::GetMuon4V();
+  };
+  virtual double GetPmu() const { return fSkimEvt ? fSkimEvt->Pmu : CVUniverseBase::GetPmu(); };
+  virtual double GetThetamu() const { return fSkimEvt ? fSkimEvt->Thetamu : CVUniverseBase::GetThetamu(); };
+  virtual double GetEmu() const { return fSkimEvt ? fSkimEvt->Emu : CVUniverseBase::GetEmu(); };
+  virtual double GetRecoilEnergy() const { return fSkimEvt ? fSkimEvt->recoilE : CVUniverseBase::GetRecoilEnergy(); };
 
   //Useful naming grab based on the inherent object in the class iself that should work *crosses fingers*
   //virtual std::string GetAnaToolName() const { return (std::string)m_chw->GetName(); }
 
   //Initial Reco Branches to investigate
-  virtual int GetNTracks() const { return GetInt("multiplicity"); };
-  virtual int GetNNeutBlobs() const { return GetInt("MasterAnaDev_BlobIs3D_sz"); };
-  virtual std::vector<double> GetEMBlobStartZVec() const { return GetVec<double>("nonvtx_iso_blobs_start_position_z_in_prong"); };
-  virtual std::vector<int> GetEMBlobNHitsVec() const { return GetVec<int>("nonvtx_iso_blobs_n_hits_in_prong"); };
-  virtual std::vector<double> GetEMBlobEnergyVec() const { return GetVec<double>("nonvtx_iso_blobs_energy_in_prong"); };
-  virtual std::vector<double> GetEMNBlobsTotalEnergyTotalNHits(double shift = 0) const {
-    std::vector<double> info;
-    double nBlobs = 0;
-    double totalE = shift;
-    double nHits = 0;
-    std::vector<double> StartZVec = GetEMBlobStartZVec();
-    std::vector<double> EnergyVec = GetEMBlobEnergyVec();
-    std::vector<int> NHitsVec = GetEMBlobNHitsVec();
-    for (unsigned int i=0; i<StartZVec.size(); ++i){
-      if (StartZVec.at(i) > 4750.0){
-	nBlobs+=1.0;
-	totalE+=EnergyVec.at(i);
-	nHits+=(double)NHitsVec.at(i);
-      }
-    }
-    info.push_back(nBlobs);
-    info.push_back(totalE);
-    info.push_back(nHits);
+  //Unshifted values go through the shared entry store, so only the first universe to ask after SetEntry reads them
+  virtual int GetNTracks() const { return Shared().GetInt(SharedEntry::kNTracks, [this]{ return fSkimEvt ? fSkimEvt->nTracks : GetBranchInt(kBranchMultiplicity); }); };
+  virtual int GetNNeutBlobs() const { return Shared().GetInt(SharedEntry::kNNeutBlobs, [this]{ return fSkimEvt ? fSkimEvt->nBlobs : GetBranchInt(kBranchNNeutBlobs); }); };
+  //A skim only keeps the EM blobs past z=4750 that ReduceEMBlobs counts, not the per-blob arrays, so with a skim attached the count is that one and the vectors come back empty.
+  virtual int GetNEMBlobs() const { return Shared().GetInt(SharedEntry::kNEMBlobs, [this]{ return fSkimEvt ? (int)fSkimEvt->emNBlobs : GetBranchInt(kBranchNEMBlobs); }); };
+  virtual ArenaVector<double> GetEMBlobStartZVec() const { return GetArenaVec(kBranchEMBlobStartZ,fSkimEvt ? 0 : GetNEMBlobs()); };
+  virtual ArenaVector<int> GetEMBlobNHitsVec() const { return GetArenaVecInt(kBranchEMBlobNHits,fSkimEvt ? 0 : GetNEMBlobs()); };
+  virtual ArenaVector<double> GetEMBlobEnergyVec() const { return GetArenaVec(kBranchEMBlobEnergy,fSkimEvt ? 0 : GetNEMBlobs()); };
+  virtual EMBlobSummary GetEMNBlobsTotalEnergyTotalNHits(double shift = 0) const {
+    EMBlobSummary info = Shared().GetEMBlobSummary([this]{ return ReduceEMBlobs(); });
+    info.totalE += shift;
     return info;
   };
 
-  virtual int GetHasInteractionVertex() const { return GetInt("has_interaction_vertex"); };
+  virtual int GetHasInteractionVertex() const { return Shared().GetInt(SharedEntry::kHasInteractionVertex, [this]{ return fSkimEvt ? fSkimEvt->hasInteractionVertex : GetBranchInt(kBranchHasInteractionVertex); }); };
+
+  virtual int GetInteractionType() const { return Shared().GetInt(SharedEntry::kInteractionType, [this]{ return fSkimEvt ? fSkimEvt->mcIntType : GetBranchInt(kBranchIntType); }); };
 
-  virtual int GetInteractionType() const { return GetInt("mc_intType"); };
+  virtual int GetMCIncoming() const { return Shared().GetInt(SharedEntry::kMCIncoming, [this]{ return fSkimEvt ? fSkimEvt->mcIncoming : GetBranchInt(kBranchMCIncoming); }); };
 
-  virtual int GetMCIncoming() const { return GetInt("mc_incoming"); };
+  virtual int GetMCCurrent() const { return Shared().GetInt(SharedEntry::kMCCurrent, [this]{ return fSkimEvt ? fSkimEvt->mcCurrent : GetBranchInt(kBranchMCCurrent); }); };
 
-  virtual int GetMCCurrent() const { return GetInt("mc_current"); };
+  //The arrays below are views: into the mapped skim record when one is attached, otherwise into the shared entry store. Nothing is copied.
+  virtual ArenaSpan<double> GetVtx() const {
+    if (fSkimEvt) return ArenaSpan<double>(fSkimEvt->vtx, 4);
+    return Shared().GetArray(SharedEntry::kVtx, [this](std::vector<double>& values){
+	values.resize(4);
+	GetBranchArray(kBranchVtx, values.data(), 4);
+      });
+  };
 
-  virtual std::vector<double> GetVtx() const { return GetVec<double>("vtx"); };
+  virtual int GetNFSPart() const { return Shared().GetInt(SharedEntry::kNFSPart, [this]{ return fSkimEvt ? fSkimEvt->nFSPart : GetBranchInt(kBranchNFSPart); }); };
 
-  virtual int GetNFSPart() const { return GetInt("mc_nFSPart"); };
+  virtual ArenaSpan<int> GetFSPartPDG() const {
+    if (fSkimEvt) return ArenaSpan<int>(fSkim->GetFSPartPDG(fEntry), fSkimEvt->nFSPart);
+    return Shared().GetFSPartPDG([this](std::vector<int>& values){
+	values.resize(CVUniverse::GetNFSPart());
+	GetBranchArray(kBranchFSPartPDG, values.data(), values.size());
+      });
+  };
 
-  virtual std::vector<int> GetFSPartPDG() const { return GetVec<int>("mc_FSPartPDG"); };
+  virtual ArenaSpan<double> GetFSPartE() const { return GetSharedFSPartArray(SharedEntry::kFSPartE, 0, kBranchFSPartE); };
 
-  virtual std::vector<double> GetFSPartE() const { return GetVec<double>("mc_FSPartE"); };
+  virtual ArenaSpan<double> GetFSPartPx() const { return GetSharedFSPartArray(SharedEntry::kFSPartPx, 1, kBranchFSPartPx); };
+  virtual ArenaSpan<double> GetFSPartPy() const { return GetSharedFSPartArray(SharedEntry::kFSPartPy, 2, kBranchFSPartPy); };
+  virtual ArenaSpan<double> GetFSPartPz() const { return GetSharedFSPartArray(SharedEntry::kFSPartPz, 3, kBranchFSPartPz); };
 
-  virtual std::vector<double> GetFSPartPx() const { return GetVec<double>("mc_FSPartPx"); };
-  virtual std::vector<double> GetFSPartPy() const { return GetVec<double>("mc_FSPartPy"); };
-  virtual std::vector<double> GetFSPartPz() const { return GetVec<double>("mc_FSPartPz"); };
+  //Truth is the same in every universe, so the FS particles are classified once per entry in the shared store
+  const TruthTopology& GetTruthTopology() const {
+    return Shared().GetTruthTopology([this](TruthTopology& truth){
+	ArenaSpan<int> PDG = CVUniverse::GetFSPartPDG();
+	ArenaSpan<double> E = CVUniverse::GetFSPartE();
+	truth.Classify(CVUniverse::GetMCCurrent(), CVUniverse::GetMCIncoming(), PDG.size(), PDG.data(), E.data());
+      });
+  };
+  bool IsTrueSignal(TruthTopology::Signal signal=TruthTopology::kCCQELikeAntiNuNeutron) const { return GetTruthTopology().IsSignal(signal); };
 
-  virtual int GetNImprovedMichel() const { return GetInt("improved_michel_vertex_type_sz"); };
+  virtual int GetNImprovedMichel() const { return Shared().GetInt(SharedEntry::kNImprovedMichel, [this]{ return fSkimEvt ? fSkimEvt->nImprovedMichel : GetBranchInt(kBranchNImprovedMichel); }); };
 
-  virtual int GetNDeadDiscriminatorsUpstreamMuon() const { return GetInt("phys_n_dead_discr_pair_upstream_prim_track_proj"); };
-  virtual int GetIsMinosMatchTrack() const { return GetInt("isMinosMatchTrack"); };
-  virtual int GetIsMinosMatchTrackOLD() const { return GetInt("muon_is_minos_match_track"); };
-  virtual int GetIsMinosMatchStub() const { return GetInt("isMinosMatchStub"); };
-  virtual int GetIsMinosMatchStubOLD() const { return GetInt("muon_is_minos_match_stub"); };
-  virtual int GetNuHelicity() const { return GetInt("MasterAnaDev_nuHelicity"); };
+  virtual int GetNDeadDiscriminatorsUpstreamMuon() const { return Shared().GetInt(SharedEntry::kNDeadDiscriminators, [this]{ return fSkimEvt ? fSkimEvt->nDeadDiscriminators : GetBranchInt(kBranchNDeadDiscriminators); }); };
+  virtual int GetIsMinosMatchTrack() const { return GetBranchInt(kBranchIsMinosMatchTrack); };
+  virtual int GetIsMinosMatchTrackOLD() const { return GetBranchInt(kBranchIsMinosMatchTrackOLD); };
+  virtual int GetIsMinosMatchStub() const { return GetBranchInt(kBranchIsMinosMatchStub); };
+  virtual int GetIsMinosMatchStubOLD() const { return GetBranchInt(kBranchIsMinosMatchStubOLD); };
+  virtual int GetNuHelicity() const { return Shared().GetInt(SharedEntry::kNuHelicity, [this]{ return fSkimEvt ? fSkimEvt->nuHelicity : GetBranchInt(kBranchNuHelicity); }); };
 
   double MeVGeV=0.001;
 
   virtual double GetCalRecoilEnergy() const{
-    if (GetVec<double>("recoil_summed_energy").size()==0) return -999.0;
-    return (GetVec<double>("recoil_summed_energy")[0]-GetDouble("recoil_energy_nonmuon_vtx100mm"));
+    return Shared().GetDouble(SharedEntry::kCalRecoil, [this]{
+	if (fSkimEvt) return fSkimEvt->calRecoilE;
+	if (GetBranchLen(kBranchRecoilSummedE)==0) return -999.0;
+	return (GetBranchValue(kBranchRecoilSummedE)-GetBranchValue(kBranchRecoilVtx100mm));
+      });
   };
 
   virtual double GetNonCalRecoilEnergy() const{
@@ -97,79 +345,242 @@ class CVUniverse: public PlotUtils::MinervaUniverse {
   
   virtual double GetEnuCCQEPickledGeV() const{ //RETURNS IN MeV^2
     int charge=-1; //hard-coded since I'm focused on anti-nu
-    double enu=PlotUtils::nuEnergyCCQE( GetEmu(), GetPmu(), GetThetamu(), charge)*MeVGeV;
-    return enu;
+    return Memo(kMemoEnuCCQE, [this, charge]{ return PlotUtils::nuEnergyCCQE( GetEmuMemo(), GetPmuMemo(), GetThetamuMemo(), charge)*MeVGeV; });
   };
 
   virtual double GetQ2QEPickledGeV() const{ //RETURNS IN MeV^2
     int charge=-1; //hard-coded since I'm focused on anti-nu
-    if (GetEnuCCQEPickledGeV()<=0.0) return 0.0;
-    else{
-      double q2=PlotUtils::qSquaredCCQE( GetEmu(), GetPmu(), GetThetamu(), charge)*MeVGeV*MeVGeV;
-      return q2;
-    }
+    return Memo(kMemoQ2QE, [this, charge]{
+	if (GetEnuCCQEPickledGeV()<=0.0) return 0.0;
+	return PlotUtils::qSquaredCCQE( GetEmuMemo(), GetPmuMemo(), GetThetamuMemo(), charge)*MeVGeV*MeVGeV;
+      });
   }
 
   virtual double GetDANRecoilEnergyGeV() const{
-    double recoilE = GetDouble("recoil_energy_nonmuon_nonvtx100mm")*MeVGeV;
-    return recoilE;
+    return Shared().GetDouble(SharedEntry::kDANRecoilGeV, [this]{
+	if (fSkimEvt) return fSkimEvt->DANRecoilEGeV;
+	return GetBranchValue(kBranchRecoilNonVtx100mm)*MeVGeV;
+      });
   }
 
   virtual double GetRecoilEnergyGeV() const{
-    double recoilE = GetRecoilEnergy()*MeVGeV;
-    return recoilE;
+    return Memo(kMemoRecoil, [this]{ return GetRecoilEnergy()*MeVGeV; });
+  }
+
+  //Fills the parts of evt (EventKinematics::Part bits) that are asked for and not yet filled, through the virtual getters, so each universe gets its own
+  //shifts. whichRecoil picks the recoil as in EventLoop (1 = DAN recoil). For particle cannon samples the first FS particle must exist, otherwise
+  //the entry gets an infinite primaryKE and fails any energy cut.
+  void FillEventKinematics(EventKinematics& evt, unsigned int parts, int isPC, int whichRecoil) const{
+    parts &= ~evt.filled;
+    if (parts & EventKinematics::kVertex){
+      ArenaSpan<double> vtx = GetVtx();
+      for (int i=0; i<3; ++i) evt.vtx[i] = vtx[i];
+    }
+    if (parts & EventKinematics::kMuon){
+      TLorentzVector muon4V = GetMuon4VMemo();
+      evt.muonPx = muon4V.X();
+      evt.muonPy = muon4V.Y();
+      evt.muonPz = muon4V.Z();
+      evt.muonE = muon4V.E();
+      evt.Pmu = GetPmuMemo();
+      evt.Thetamu = GetThetamuMemo();
+    }
+    if (parts & EventKinematics::kRecoil){
+      evt.EnuGeV = GetEnuCCQEPickledGeV();
+      evt.Q2GeV = GetQ2QEPickledGeV();
+      evt.recoilEGeV = (whichRecoil == 1) ? GetDANRecoilEnergyGeV() : GetRecoilEnergyGeV();
+    }
+    if (parts & EventKinematics::kPrimary){
+      evt.primaryKE = 0.0;
+      if (isPC){
+	if (GetNFSPart() > 0){
+	  ArenaSpan<double> E = GetFSPartE(), Px = GetFSPartPx(), Py = GetFSPartPy(), Pz = GetFSPartPz();
+	  TLorentzVector prim_part(Px[0],Py[0],Pz[0],E[0]);
+	  evt.primaryKE = prim_part.E()-prim_part.M();
+	}
+	else evt.primaryKE = std::numeric_limits<double>::infinity();
+      }
+    }
+    if (parts & EventKinematics::kCounts){
+      evt.nTracks = GetNTracks();
+      evt.nImprovedMichel = GetNImprovedMichel();
+      evt.hasInteractionVertex = GetHasInteractionVertex();
+      evt.nDeadDiscriminators = GetNDeadDiscriminatorsUpstreamMuon();
+      evt.nuHelicity = GetNuHelicity();
+    }
+    if (parts & EventKinematics::kEMBlobs) evt.EMBlobs = GetEMNBlobsTotalEnergyTotalNHits();
+    if (parts & EventKinematics::kTruth) evt.intType = GetInteractionType();
+    evt.filled |= parts;
   }
 
   //Neutron Candidate Business
 
+  //Reads blob "index" into row "row" of cands through the NeutCands branch tables.
+  virtual void FillNeutCandRow(NeutronCandidates::NeutCands& cands, int row, int index) const{
+    const auto& intBranches = NeutronCandidates::NeutCands::IntBranches();
+    const auto& doubleBranches = NeutronCandidates::NeutCands::DoubleBranches();
+    for (unsigned int iBranch=0; iBranch < intBranches.size(); ++iBranch){
+      cands.Set(intBranches[iBranch], row, fIntBlobBranches[iBranch].GetInt(fEntry,index));
+    }
+    for (unsigned int iBranch=0; iBranch < doubleBranches.size(); ++iBranch){
+      cands.Set(doubleBranches[iBranch], row, fDoubleBlobBranches[iBranch].GetValue(fEntry,index));
+    }
+  };
+
   virtual NeutronCandidates::NeutCand GetNeutCand(int index){
-    std::vector<double> vtx = GetVtx();
-    TVector3 EvtVtx;
-    EvtVtx.SetXYZ(vtx.at(0),vtx.at(1),vtx.at(2));
-    NeutronCandidates::intCandData intData;
-    NeutronCandidates::doubleCandData doubleData;
-    for (const auto& intMember: NeutronCandidates::GetBranchIntMap()){
-      intData[intMember.first]={};
-      for (const auto& branchName: intMember.second){
-	intData[intMember.first].push_back(GetVecElemInt(branchName,index));
-      }
+    ArenaSpan<double> vtx = GetVtx();
+    NeutronCandidates::NeutCands cands;
+    cands.Clear(TVector3(vtx.at(0),vtx.at(1),vtx.at(2)));
+    cands.Resize(1);
+    FillNeutCandRow(cands, 0, index);
+    cands.Finalize();
+    return cands.GetCandView(0).MakeCand();
+  };
+
+  //Refills an existing column store in place so its storage is reused from entry to entry.
+  virtual void FillNeutCands(NeutronCandidates::NeutCands& cands){
+    if (fSkimEvt){
+      fSkim->FillNeutCands(fEntry, cands);
+      return;
     }
-    for (const auto& doubleMember: NeutronCandidates::GetBranchDoubleMap()){
-      doubleData[doubleMember.first]={};
-      for (const auto& branchName: doubleMember.second){
-	doubleData[doubleMember.first].push_back(GetVecElem(branchName,index));
+    ArenaSpan<double> vtx = GetVtx();
+    cands.Clear(TVector3(vtx.at(0),vtx.at(1),vtx.at(2)));
+    int nBlobs = GetNNeutBlobs();
+    cands.Resize(nBlobs);
+    if (nBlobs > 0){
+      //Whole columns straight off each blob branch's leaf; entries past the blob count are ignored
+      const auto& intBranches = NeutronCandidates::NeutCands::IntBranches();
+      const auto& doubleBranches = NeutronCandidates::NeutCands::DoubleBranches();
+      //Each branch is loaded once into an arena buffer and copied in as a column; rows the leaf is too short for keep their Resize defaults
+      int* intValues = static_cast<int*>(fArena.Allocate(nBlobs*sizeof(int), alignof(int)));
+      double* doubleValues = static_cast<double*>(fArena.Allocate(nBlobs*sizeof(double), alignof(double)));
+      for (unsigned int iBranch=0; iBranch < intBranches.size(); ++iBranch){
+	int nValues = fIntBlobBranches[iBranch].GetArray(fEntry, intValues, nBlobs);
+	cands.SetColumn(intBranches[iBranch], intValues, nValues);
+      }
+      for (unsigned int iBranch=0; iBranch < doubleBranches.size(); ++iBranch){
+	int nValues = fDoubleBlobBranches[iBranch].GetArray(fEntry, doubleValues, nBlobs);
+	cands.SetColumn(doubleBranches[iBranch], doubleValues, nValues);
       }
     }
-    return NeutronCandidates::NeutCand(intData,doubleData,EvtVtx);
+    cands.Finalize();
   };
-  
+
   virtual NeutronCandidates::NeutCands GetNeutCands(){
-    std::vector<NeutronCandidates::NeutCand> cands;
-    int nBlobs = GetNNeutBlobs();
-    for(int neutBlobIndex=0; neutBlobIndex < nBlobs; ++neutBlobIndex){
-      cands.push_back(GetNeutCand(neutBlobIndex));
-    }
-    NeutronCandidates::NeutCands EvtCands(cands);
+    NeutronCandidates::NeutCands EvtCands;
+    FillNeutCands(EvtCands);
     return EvtCands;
   };
 
+  //Universes that change blob quantities return true and edit their own copy of the shared candidates in ShiftNeutCands, e.g. with NeutCands::Set
+  virtual bool ShiftsNeutCands() const { return false; };
+  virtual void ShiftNeutCands(NeutronCandidates::NeutCands& cands) const {};
+
+  //Candidates are built once per entry in the shared store. Universes that leave blobs alone read that store; the others get a private copy to shift.
   virtual void UpdateNeutCands(){
-    NeutronCandidates::NeutCands candsIn = GetNeutCands();
-    fNeutCands = candsIn;
-    fNNeutCands = candsIn.GetNCands();
+    const NeutronCandidates::NeutCands& shared = Shared().GetNeutCands([this](NeutronCandidates::NeutCands& cands){ CVUniverse::FillNeutCands(cands); });
+    if (ShiftsNeutCands()){
+      fNeutCands = shared;
+      ShiftNeutCands(fNeutCands);
+      fNeutCands.Finalize();
+      fCurrentCands = &fNeutCands;
+    }
+    else fCurrentCands = &shared;
+    fNNeutCands = fCurrentCands->GetNCands();
   };
 
-  NeutronCandidates::NeutCand GetCurrentNeutCand(int index) { return fNeutCands.GetCandidate(index); };
+  //Looks the candidate up by blob ID; a missing ID gives a default NeutCand
+  NeutronCandidates::NeutCand GetCurrentNeutCand(int ID) const { return Cands().GetCandidate(ID); };
+
+  NeutronCandidates::NeutCand GetCurrentLeadingNeutCand() const { return Cands().GetMaxCandidate(); };
+
+  NeutronCandidates::NeutCandView GetCurrentNeutCandView(int index) const { return Cands().GetCandView(index); };
+
+  NeutronCandidates::NeutCandView GetCurrentLeadingNeutCandView() const { return Cands().GetMaxCandView(); };
+
+  NeutronCandidates::NeutCandView GetCurrentSubleadingNeutCandView() const { return Cands().GetSubleadingCandView(); };
+
+  NeutronCandidates::NeutCands::ranked_range GetCurrentTopNeutCands(int k) const { return Cands().GetTopCands(k); };
+
+  NeutronCandidates::NeutCandView FindCurrentNeutCand(int ID) const { return Cands().FindCand(ID); };
 
-  NeutronCandidates::NeutCand GetCurrentLeadingNeutCand() { return fNeutCands.GetMaxCandidate(); };
+  //Reference to this universe's store; valid until the next UpdateNeutCands
+  const NeutronCandidates::NeutCands& GetCurrentNeutCands() const { return Cands(); };
 
-  NeutronCandidates::NeutCands GetCurrentNeutCands() { return fNeutCands; };
+  int GetNNeutCandsPassing(std::bitset<4> required) const { return Cands().GetNPassing(required); };
 
-  int GetNNeutCands(){ return fNNeutCands; }
+  int GetNNeutCands() const { return fNNeutCands; }
   
  private:
+  mutable EventArena fArena;
+  const SkimReader* fSkim;
+  const SkimEvent* fSkimEvt;
+  Long64_t fEntry;
+  mutable std::vector<BranchHandle> fBranches;
+  mutable std::vector<BranchHandle> fIntBlobBranches;
+  mutable std::vector<BranchHandle> fDoubleBlobBranches;
+  SharedEntry* fShared;
+  mutable SharedEntry fOwnShared;
+
+  mutable unsigned int fMemoValid;
+  mutable double fMemo[kNMemoSlots];
+  mutable TLorentzVector fMemoMuon4V;
+  mutable unsigned long long fMemoHits;
+  mutable unsigned long long fMemoMisses;
+
+  //Counts a hit or a miss; on a miss the caller computes the value and calls SetMemoized
+  bool IsMemoized(MemoSlot slot) const {
+    if (fMemoValid & (1u << slot)){
+      ++fMemoHits;
+      return true;
+    }
+    ++fMemoMisses;
+    return false;
+  };
+  void SetMemoized(MemoSlot slot) const { fMemoValid |= (1u << slot); };
+
+  template <typename F> double Memo(MemoSlot slot, F compute) const {
+    if (!IsMemoized(slot)){
+      fMemo[slot] = compute();
+      SetMemoized(slot);
+    }
+    return fMemo[slot];
+  };
+
+  SharedEntry& Shared() const { return fShared ? *fShared : fOwnShared; };
+
+  //which: the skim's FS array, 0=E, 1=Px, 2=Py, 3=Pz
+  ArenaSpan<double> GetSharedFSPartArray(SharedEntry::ArraySlot slot, int which, BranchID id) const {
+    if (fSkimEvt) return ArenaSpan<double>(fSkim->GetFSPartArray(fEntry, which), fSkimEvt->nFSPart);
+    return Shared().GetArray(slot, [this, id](std::vector<double>& values){
+	values.resize(CVUniverse::GetNFSPart());
+	GetBranchArray(id, values.data(), values.size());
+      });
+  };
+
+  //Unshifted EM blob sums over blobs downstream of z=4750. The three branches are read whole into arena arrays and reduced in one pass;
+  //this uses the CVUniverse blob count so the shared value doesn't depend on which universe asks first.
+  EMBlobSummary ReduceEMBlobs() const {
+    if (fSkimEvt){
+      EMBlobSummary summary = {fSkimEvt->emNBlobs, fSkimEvt->emTotalE, fSkimEvt->emNHits};
+      return summary;
+    }
+    int nEMBlobs = CVUniverse::GetNEMBlobs();
+    double* startZ = static_cast<double*>(fArena.Allocate(nEMBlobs*sizeof(double), alignof(double)));
+    double* energy = static_cast<double*>(fArena.Allocate(nEMBlobs*sizeof(double), alignof(double)));
+    int* nHits = static_cast<int*>(fArena.Allocate(nEMBlobs*sizeof(int), alignof(int)));
+    GetBranchArray(kBranchEMBlobStartZ, startZ, nEMBlobs);
+    GetBranchArray(kBranchEMBlobEnergy, energy, nEMBlobs);
+    GetBranchArray(kBranchEMBlobNHits, nHits, nEMBlobs);
+    return SumEMBlobs(nEMBlobs, startZ, energy, nHits, 4750.0);
+  };
   NeutronCandidates::NeutCands fNeutCands;
+  const NeutronCandidates::NeutCands* fCurrentCands;
   int fNNeutCands;
+  int fWeightIndex;
+  int fBandFactor;
+
+  const NeutronCandidates::NeutCands& Cands() const { return fCurrentCands ? *fCurrentCands : fNeutCands; };
 };
 
 #endif
@@ -0,0 +1,134 @@
+//File: SharedEntry.h
+//Info: Per-entry store of the unshifted quantities that every universe on a chain reads the same way (vertex, truth record and topology, counters, recoil, EM blob summary, neutron candidates).
+//      Universes own one each by default; CVUniverse::SetSharedEntry points a set of universes at a common one.
+//      Each value is computed by whichever universe asks first after SetEntry and served to the rest, so adding universes doesn't add reads.
+//      A universe that shifts one of these quantities overrides its getter and calls the CVUniverse one for the unshifted value.
+//
+//Author: David Last dlast@sas.upenn.edu/lastd44@gmail.com
+
+#ifndef SHAREDENTRY_H
+#define SHAREDENTRY_H
+
+#include "obj/NeutCands.h"
+#include "obj/EMBlobSummary.h"
+#include "obj/TruthTopology.h"
+#include <vector>
+
+class SharedEntry{
+ public:
+  enum IntSlot{ kNTracks, kNNeutBlobs, kNEMBlobs, kHasInteractionVertex, kInteractionType, kMCIncoming, kMCCurrent, kNFSPart, kNImprovedMichel, kNDeadDiscriminators, kNuHelicity, kNIntSlots };
+  enum DoubleSlot{ kCalRecoil, kDANRecoilGeV, kNDoubleSlots };
+  enum ArraySlot{ kVtx, kFSPartE, kFSPartPx, kFSPartPy, kFSPartPz, kNArraySlots };
+
+ private:
+  long long fEntry;
+  unsigned int fIntValid;
+  unsigned int fDoubleValid;
+  unsigned int fArrayValid;
+  bool fPDGValid;
+  int fInts[kNIntSlots];
+  double fDoubles[kNDoubleSlots];
+  std::vector<double> fArrays[kNArraySlots];
+  std::vector<int> fFSPartPDG;
+  bool fEMValid;
+  EMBlobSummary fEMBlobs;
+  bool fTruthValid;
+  TruthTopology fTruth;
+  bool fCandsValid;
+  NeutronCandidates::NeutCands fNeutCands;
+  unsigned long long fHits;
+  unsigned long long fMisses;
+
+  bool Has(unsigned int valid, int slot){
+    if (valid & (1u << slot)){
+      ++fHits;
+      return true;
+    }
+    ++fMisses;
+    return false;
+  };
+
+ public:
+  //CTOR
+  SharedEntry(): fEntry(-1), fIntValid(0), fDoubleValid(0), fArrayValid(0), fPDGValid(false), fEMValid(false), fTruthValid(false), fCandsValid(false), fHits(0), fMisses(0) {};
+
+  //Every universe calls this from its own SetEntry; only a change of entry clears the store
+  void SetEntry(long long entry){
+    if (entry == fEntry) return;
+    fEntry = entry;
+    fIntValid = 0;
+    fDoubleValid = 0;
+    fArrayValid = 0;
+    fPDGValid = false;
+    fEMValid = false;
+    fTruthValid = false;
+    fCandsValid = false;
+  };
+
+  template <typename F> int GetInt(IntSlot slot, F compute){
+    if (!Has(fIntValid, slot)){
+      fInts[slot] = compute();
+      fIntValid |= (1u << slot);
+    }
+    return fInts[slot];
+  };
+
+  template <typename F> double GetDouble(DoubleSlot slot, F compute){
+    if (!Has(fDoubleValid, slot)){
+      fDoubles[slot] = compute();
+      fDoubleValid |= (1u << slot);
+    }
+    return fDoubles[slot];
+  };
+
+  //fill(std::vector<double>&) replaces the contents; the vector's storage is reused from entry to entry
+  template <typename F> const std::vector<double>& GetArray(ArraySlot slot, F fill){
+    if (!Has(fArrayValid, slot)){
+      fArrays[slot].clear();
+      fill(fArrays[slot]);
+      fArrayValid |= (1u << slot);
+    }
+    return fArrays[slot];
+  };
+
+  template <typename F> const std::vector<int>& GetFSPartPDG(F fill){
+    if (!Has(fPDGValid, 0)){
+      fFSPartPDG.clear();
+      fill(fFSPartPDG);
+      fPDGValid = true;
+    }
+    return fFSPartPDG;
+  };
+
+  //Unshifted EM blob summary
+  template <typename F> const EMBlobSummary& GetEMBlobSummary(F compute){
+    if (!Has(fEMValid, 0)){
+      fEMBlobs = compute();
+      fEMValid = true;
+    }
+    return fEMBlobs;
+  };
+
+  //classify(TruthTopology&) classifies the FS particles; done once per entry however many universes and signal definitions ask
+  template <typename F> const TruthTopology& GetTruthTopology(F classify){
+    if (!Has(fTruthValid, 0)){
+      classify(fTruth);
+      fTruthValid = true;
+    }
+    return fTruth;
+  };
+
+  //fill(NeutCands&) refills the store in place; it is built once per entry and read by every universe that leaves blobs alone
+  template <typename F> const NeutronCandidates::NeutCands& GetNeutCands(F fill){
+    if (!Has(fCandsValid, 0)){
+      fill(fNeutCands);
+      fCandsValid = true;
+    }
+    return fNeutCands;
+  };
+
+  unsigned long long GetHits() const { return fHits; };
+  unsigned long long GetMisses() const { return fMisses; };
+};
+
+#endif
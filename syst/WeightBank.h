@@ -0,0 +1,64 @@
+//File: WeightBank.h
+//Info: Per-entry event weights for every universe of every error band, stored contiguously in band order.
+//      Histogram fills look their universe's weight up by index instead of calling back into the weight functions on every fill.
+//      Each band's weights come from one CVUniverse::GetBandWeights call, which universes that share their reweighting inputs can override to batch.
+//      A band is only computed the first time one of its universes asks for a weight in an entry, so entries nobody selects cost nothing.
+//
+//Author: David Last dlast@sas.upenn.edu/lastd44@gmail.com
+
+#ifndef WEIGHTBANK_H
+#define WEIGHTBANK_H
+
+#include "syst/CVUniverse.h"
+#include <map>
+#include <string>
+#include <vector>
+
+class WeightBank{
+ private:
+  std::vector<const CVUniverse*> fUniverses;
+  //[first, last) of each band in fUniverses/fWeights
+  std::vector<std::pair<int,int>> fBands;
+  std::vector<double> fWeights;
+  //Band of each universe, by weight index, and whether each band's weights are for the current entry
+  std::vector<int> fBandOf;
+  std::vector<char> fBandCurrent;
+  bool fEnabled;
+
+  void UpdateBand(int band){
+    const std::pair<int,int>& range = fBands[band];
+    fUniverses[range.first]->GetBandWeights(&fUniverses[range.first], range.second-range.first, &fWeights[range.first]);
+    fBandCurrent[band] = 1;
+  };
+
+ public:
+  //CTOR. Disabled, every weight is 1 and the weight functions are never called.
+  WeightBank(std::map<std::string, std::vector<CVUniverse*>>& error_bands, bool enabled): fEnabled(enabled) {
+    for (auto& band : error_bands){
+      int first = fUniverses.size();
+      for (auto universe : band.second){
+	universe->SetWeightIndex(fUniverses.size());
+	fUniverses.push_back(universe);
+	fBandOf.push_back(fBands.size());
+      }
+      fBands.push_back(std::make_pair(first, (int)fUniverses.size()));
+    }
+    fWeights.assign(fUniverses.size(), 1.0);
+    fBandCurrent.assign(fBands.size(), 0);
+  };
+
+  //Call once per entry, alongside the universes' SetEntry. Nothing is computed until a weight is asked for.
+  void SetEntry(){
+    if (fEnabled) fBandCurrent.assign(fBands.size(), 0);
+  };
+
+  //Computes the universe's whole band on the first call in an entry, so only ask once the universe has passed the selection
+  double GetWeight(const CVUniverse* universe){
+    int index = universe->GetWeightIndex();
+    if (fEnabled && !fBandCurrent[fBandOf[index]]) UpdateBand(fBandOf[index]);
+    return fWeights[index];
+  };
+  bool IsEnabled() const { return fEnabled; };
+};
+
+#endif